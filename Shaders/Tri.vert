@@ -9,13 +9,23 @@ layout(set = 0, binding = 0) uniform Global_Camera {
 	mat4 ViewProj;
 } Camera;
 
-layout(push_constant) uniform PushConst {
+struct Object {
 	mat4 Model;
-} PC;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer ObjectBuffer {
+	Object Objects[];
+};
+
+// The object drawn by each instance. gl_InstanceIndex includes the draw's first instance.
+layout(std430, set = 0, binding = 2) readonly buffer InstanceBuffer {
+	uint Instances[];
+};
 
 layout(location = 0) out vec3 outNormal;
 
 void main() {
 	outNormal = inNormal;
-	gl_Position = Camera.ViewProj * PC.Model * vec4(inPosition, 1.0f);
+	const mat4 model = Objects[Instances[gl_InstanceIndex]].Model;
+	gl_Position = Camera.ViewProj * model * vec4(inPosition, 1.0f);
 }
\ No newline at end of file
@@ -5,11 +5,24 @@
 #include "Application.h"
 #include "Core.h"
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <glm/gtc/matrix_transform.hpp>
+#include <json.hpp>
 #include <tiny_gltf.h>
 
+#include "FileWatcher.h"
+#include "Frustum.h"
+#include "JobSystem.h"
+#include "MeshCache.h"
+#include "MeshProcessing.h"
+#include "TransferManager.h"
 #include "VulkanCore.h"
 #include "Window.h"
 
@@ -93,7 +106,9 @@ VkBool32 VulkanDebugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSever
   switch (messageSeverity) {
     case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
       Log::Error("[Vulkan-ERR-{}] {}", msgType, msg);
+#ifdef _WIN32
       __debugbreak();
+#endif
       break;
     case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
       Log::Warn("[Vulkan-WRN-{}] {}", msgType, msg);
@@ -124,6 +139,22 @@ constexpr const vk::DebugUtilsMessengerCreateInfoEXT gDebugMessengerCI(
         vk::DebugUtilsMessageTypeFlagBitsEXT::eValidation,
     VulkanDebugCallback, nullptr);
 
+// Fewer batches than this per job and the cost of handing work to another thread outweighs the
+// recording it saves.
+constexpr static size_t gMinBatchesPerRecordJob{64};
+// Room for camera, material and per-draw uniforms in each frame's uniform allocator.
+constexpr static vk::DeviceSize gFrameUniformSize{1024 * 1024};
+constexpr static const char* gPipelineCachePath{"Pipelines.rvcache"};
+// Compiled shaders, relative to the working directory.
+constexpr static const char* gShaderBinaryDir{"../Shaders"};
+// Instance counts for the named --benchmark scene scales.
+constexpr static std::array<std::pair<const char*, uint32_t>, 3> gBenchmarkPresets{
+    {{"small", 2500}, {"medium", 25000}, {"large", 100000}}};
+// Frames rendered before benchmark statistics are collected, and measured frames when no frame
+// count is given.
+constexpr static uint64_t gBenchmarkWarmupFrames{100};
+constexpr static uint64_t gBenchmarkFrames{1000};
+
 /* ==========================================================================================
  * Local Helper Classes
  * ========================================================================================== */
@@ -154,6 +185,14 @@ class InstanceBuilder final {
     return *this;
   }
 
+  InstanceBuilder& RequireSurface(bool surface = true) noexcept {
+    mRequireSurface = surface;
+
+    return *this;
+  }
+
+  bool ValidationEnabled() const noexcept { return mValidationEnabled; }
+
   operator vk::InstanceCreateInfo() {
     mAppInfo = vk::ApplicationInfo(mAppName.c_str(), mAppVersion, "Raven", VK_MAKE_VERSION(1, 0, 0),
                                    mRequiredVersion);
@@ -163,8 +202,12 @@ class InstanceBuilder final {
 
     mLayers.clear();
     mExtensions.clear();
-    mExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
-    mExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+    if (mRequireSurface) {
+      mExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+#ifdef _WIN32
+      mExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+#endif
+    }
 
     bool validation{false};
     if (mRequestValidation) {
@@ -209,6 +252,7 @@ class InstanceBuilder final {
         validation = true;
       }
     }
+    mValidationEnabled = validation;
 
     return vk::InstanceCreateInfo({}, &mAppInfo, mLayers, mExtensions);
   }
@@ -218,6 +262,8 @@ class InstanceBuilder final {
   std::string mAppName{"Raven"};
   uint32_t mAppVersion{VK_MAKE_VERSION(1, 0, 0)};
   bool mRequestValidation{false};
+  bool mValidationEnabled{false};
+  bool mRequireSurface{true};
   uint32_t mRequiredVersion{VK_API_VERSION_1_0};
 
   std::vector<const char*> mLayers;
@@ -237,6 +283,12 @@ class PipelineLayoutBuilder final {
     return *this;
   }
 
+  PipelineLayoutBuilder& AddPushConstants(const std::vector<vk::PushConstantRange>& ranges) {
+    PushConstants.insert(PushConstants.end(), ranges.begin(), ranges.end());
+
+    return *this;
+  }
+
   PipelineLayoutBuilder& AddSetLayout(const vk::DescriptorSetLayout layout) {
     DescriptorSetLayouts.push_back(layout);
 
@@ -247,164 +299,336 @@ class PipelineLayoutBuilder final {
   std::vector<vk::DescriptorSetLayout> DescriptorSetLayouts;
 };
 
-class PipelineBuilder final {
- public:
-  PipelineBuilder(vk::Extent2D extent) {
-    InputAssembly =
-        vk::PipelineInputAssemblyStateCreateInfo({}, vk::PrimitiveTopology::eTriangleList, false);
-
-    Viewport = vk::Viewport(0, 0, extent.width, extent.height, 0.0f, 1.0f);
-    Scissor = vk::Rect2D({0, 0}, extent);
-
-    Rasterizer = vk::PipelineRasterizationStateCreateInfo(
-        {}, false, false, vk::PolygonMode::eFill, vk::CullModeFlagBits::eNone,
-        vk::FrontFace::eCounterClockwise, false, 0.0f, 0.0f, 0.0f, 1.0f);
-
-    Multisampling = vk::PipelineMultisampleStateCreateInfo();
+/* ==========================================================================================
+ * Local Helper Functions
+ * ========================================================================================== */
 
-    DepthStencil = vk::PipelineDepthStencilStateCreateInfo();
+// Compiled SPIR-V for a shader source file name, such as "Basic.vert". Hot reload looks shaders up
+// by this path, so every shader must be loaded through it.
+static std::string GetShaderPath(const std::string& name) {
+  return fmt::format("{}/{}.spv", gShaderBinaryDir, name);
+}
 
-    ColorAttachment = vk::PipelineColorBlendAttachmentState(
-        true, vk::BlendFactor::eSrcAlpha, vk::BlendFactor::eOneMinusSrcAlpha, vk::BlendOp::eAdd,
-        vk::BlendFactor::eOne, vk::BlendFactor::eZero, vk::BlendOp::eAdd,
-        vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
-            vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA);
-    ColorBlending =
-        vk::PipelineColorBlendStateCreateInfo({}, false, vk::LogicOp::eCopy, ColorAttachment);
+// Parses the whole of a numeric command line value. Malformed or out of range values are reported
+// and leave result unchanged.
+template <typename T>
+static bool ParseArgument(const std::string& arg, const std::string& value, T& result) {
+  T parsed{};
+  const char* last{value.data() + value.size()};
+  const auto [end, error]{std::from_chars(value.data(), last, parsed)};
+  if (error != std::errc() || end != last) {
+    Log::Warn("Invalid value for {}: {}", arg, value);
+    return false;
   }
+  result = parsed;
 
-  operator vk::GraphicsPipelineCreateInfo() {
-    ViewportState = vk::PipelineViewportStateCreateInfo({}, Viewport, Scissor);
+  return true;
+}
 
-    return vk::GraphicsPipelineCreateInfo({}, ShaderStages, &VertexInput, &InputAssembly,
-                                          &Tesselation, &ViewportState, &Rasterizer, &Multisampling,
-                                          &DepthStencil, &ColorBlending, {}, Layout, RenderPass, 0);
-  }
+/* ==========================================================================================
+ * Public Application Methods
+ * ========================================================================================== */
 
-  PipelineBuilder& AddShader(vk::ShaderStageFlagBits stage, vk::ShaderModule& shader) {
-    ShaderStages.push_back(vk::PipelineShaderStageCreateInfo({}, stage, shader, "main"));
+Application::Application(const std::vector<const char*>& cmdArgs) {
+  Log::Info("Raven is starting...");
+  Profiler::SetThreadName("Main");
+  mValidation = true;
 
-    return *this;
+  for (size_t i = 1; i < cmdArgs.size(); i++) {
+    const std::string arg{cmdArgs[i]};
+    const bool hasValue{i + 1 < cmdArgs.size()};
+    if (arg == "--headless") {
+      mHeadless = true;
+    } else if (arg == "--no-validation") {
+      mValidation = false;
+    } else if (arg == "--gpu-culling") {
+      mGpuCulling = true;
+    } else if (arg == "--frames-in-flight" && hasValue) {
+      ParseArgument(arg, cmdArgs[++i], mFramesInFlight);
+    } else if (arg == "--frame-pacing" && hasValue) {
+      const std::string pacing{cmdArgs[++i]};
+      if (pacing == "latency") {
+        mFramesInFlight = LowLatencyFramesInFlight;
+      } else if (pacing == "throughput") {
+        mFramesInFlight = ThroughputFramesInFlight;
+      } else {
+        Log::Warn("Unknown frame pacing preset: {}", pacing);
+      }
+    } else if (arg == "--record-threads" && hasValue) {
+      ParseArgument(arg, cmdArgs[++i], mRecordThreads);
+    } else if ((arg == "--width" || arg == "--height") && hasValue) {
+      uint32_t& extent{arg == "--width" ? mHeadlessExtent.width : mHeadlessExtent.height};
+      uint32_t value{extent};
+      if (ParseArgument(arg, cmdArgs[++i], value)) {
+        if (value > 0) {
+          extent = value;
+        } else {
+          Log::Warn("{} must be greater than zero, using {}.", arg, extent);
+        }
+      }
+    } else if (arg == "--frames" && hasValue) {
+      ParseArgument(arg, cmdArgs[++i], mFrameLimit);
+    } else if (arg == "--capture" && hasValue) {
+      mFinalCapturePath = cmdArgs[++i];
+    } else if (arg == "--frame-budget" && hasValue) {
+      float budget{0.0f};
+      if (ParseArgument(arg, cmdArgs[++i], budget)) {
+        if (budget > 0.0f) {
+          mFrameStats.SetBudget(budget);
+        } else {
+          Log::Warn("{} must be greater than zero, using {:.2f}ms.", arg, mFrameStats.Budget());
+        }
+      }
+    } else if (arg == "--frame-stats" && hasValue) {
+      mFrameStatsPath = cmdArgs[++i];
+    } else if (arg == "--benchmark") {
+      // Usage: --benchmark [small|medium|large|instanceCount]
+      mBenchmarkInstances = gBenchmarkPresets[1].second;
+      if (hasValue && std::strncmp(cmdArgs[i + 1], "--", 2) != 0) {
+        const std::string scale{cmdArgs[++i]};
+        const auto preset{std::find_if(gBenchmarkPresets.begin(), gBenchmarkPresets.end(),
+                                       [&scale](const auto& p) { return scale == p.first; })};
+        uint32_t count{0};
+        if (preset != gBenchmarkPresets.end()) {
+          mBenchmarkInstances = preset->second;
+        } else if (ParseArgument(arg, scale, count) && count > 0) {
+          mBenchmarkInstances = count;
+        } else {
+          Log::Warn("Invalid benchmark scale: {}, using {} instances.", scale,
+                    mBenchmarkInstances);
+        }
+      }
+    } else if (arg == "--benchmark-report" && hasValue) {
+      mBenchmarkReportPath = cmdArgs[++i];
+    } else if (arg == "--trace" && hasValue) {
+      mTracePath = cmdArgs[++i];
+    } else if (arg == "--trace-start" && hasValue) {
+      ParseArgument(arg, cmdArgs[++i], mTraceStart);
+    } else if (arg == "--trace-frames" && hasValue) {
+      ParseArgument(arg, cmdArgs[++i], mTraceFrames);
+    } else {
+      Log::Warn("Unknown command line argument: {}", arg);
+    }
   }
 
-  PipelineBuilder& ClearShaders() {
-    ShaderStages.clear();
-
-    return *this;
+  if (mFramesInFlight < 1 || mFramesInFlight > MaxFramesInFlight) {
+    Log::Warn("Frames in flight must be between 1 and {}, clamping.", MaxFramesInFlight);
+    mFramesInFlight = std::clamp(mFramesInFlight, 1u, MaxFramesInFlight);
   }
+  mFrames.resize(mFramesInFlight);
 
-  template <typename T>
-  PipelineBuilder& SetVertexInput() {
-    VertexInfo = T::GetVertexDescription();
-    VertexInput =
-        vk::PipelineVertexInputStateCreateInfo({}, VertexInfo.Bindings, VertexInfo.Attributes);
-
-    return *this;
+  // A benchmark always runs for a fixed number of frames, with --frames counting measured frames.
+  if (mBenchmarkInstances > 0) {
+    mFrameLimit = gBenchmarkWarmupFrames + (mFrameLimit > 0 ? mFrameLimit : gBenchmarkFrames);
+    Log::Info("Benchmarking {} instances over {} frames.", mBenchmarkInstances,
+              mFrameLimit - gBenchmarkWarmupFrames);
   }
 
-  PipelineBuilder& EnableDepthBuffer() {
-    DepthStencil = vk::PipelineDepthStencilStateCreateInfo({}, true, true, vk::CompareOp::eLess,
-                                                           false, false, {}, {}, 0.0f, 1.0f);
-
-    return *this;
+  if (!mTracePath.empty() && mTraceStart == 0) {
+    Profiler::SetEnabled(true);
   }
+  mFrameStats.OpenCsv(mFrameStatsPath);
 
-  std::vector<vk::PipelineShaderStageCreateInfo> ShaderStages;
-  VertexDescription VertexInfo;
-  vk::PipelineVertexInputStateCreateInfo VertexInput;
-  vk::PipelineInputAssemblyStateCreateInfo InputAssembly;
-  vk::PipelineTessellationStateCreateInfo Tesselation;
-  vk::Viewport Viewport;
-  vk::Rect2D Scissor;
-  vk::PipelineViewportStateCreateInfo ViewportState;
-  vk::PipelineRasterizationStateCreateInfo Rasterizer;
-  vk::PipelineMultisampleStateCreateInfo Multisampling;
-  vk::PipelineDepthStencilStateCreateInfo DepthStencil;
-  vk::PipelineColorBlendAttachmentState ColorAttachment;
-  vk::PipelineColorBlendStateCreateInfo ColorBlending;
-  vk::PipelineLayout Layout;
-  vk::RenderPass RenderPass;
-};
+#ifndef _WIN32
+  if (!mHeadless) {
+    Log::Warn("Windowed mode is not supported on this platform, running headless.");
+    mHeadless = true;
+  }
+#endif
 
-/* ==========================================================================================
- * Public Application Methods
- * ========================================================================================== */
+  mJobs = std::make_unique<JobSystem>();
+  if (mRecordThreads == 0 || mRecordThreads > mJobs->WorkerCount() + 1) {
+    mRecordThreads = mJobs->WorkerCount() + 1;
+  }
 
-Application::Application(const std::vector<const char*>& cmdArgs) {
-  // TODO: Command line arguments?
-  Log::Info("Raven is starting...");
-  mValidation = true;
-  mWindow = std::make_shared<Window>();
+  if (!mHeadless) {
+    mWindow = std::make_shared<Window>();
+  }
   InitializeVulkan();
 }
 
 Application::~Application() {
   Log::Info("Raven is shutting down...");
   ShutdownVulkan();
+  mFrameStats.LogStats();
+  mFrameStats.CloseCsv();
+  if (mBenchmarkInstances > 0) {
+    WriteBenchmarkReport();
+  }
+  if (!mTracePath.empty()) {
+    FinishTrace();
+  }
 }
 
 void Application::Run() {
   mRunning = true;
 
   auto startTime{std::chrono::high_resolution_clock::now()};
-  float msAcc{0.0f};
+  auto titleTime{startTime};
+  float recordMsAcc{0.0f};
   uint64_t sampleCount{0};
   while (mRunning) {
+    if (sampleCount > 0 && startTime - titleTime > std::chrono::seconds(1)) {
+      titleTime = startTime;
+      // Percentiles over the recent window, so a single spike shows up instead of averaging out.
+      const FrameStatsSummary stats{mFrameStats.GetWindowStats()};
+      // The window is empty straight after a Reset, such as at the end of a benchmark warm-up.
+      const uint32_t fps{stats.Cpu.Samples > 0 && stats.Cpu.AvgMs > 0.0f
+                             ? static_cast<uint32_t>(1000.0f / stats.Cpu.AvgMs)
+                             : 0};
+      std::string title{fmt::format(
+          "Raven - {:.2f}ms ({} FPS), p99 {:.2f}ms, {} hitches - {} draws, {:.3f}ms record",
+          stats.Cpu.AvgMs, fps, stats.Cpu.P99Ms, stats.Hitches, mDrawCalls,
+          recordMsAcc / sampleCount)};
+      // GPU culling results never come back to the CPU.
+      if (!mGpuCulling) {
+        title += fmt::format(", {} visible, {} culled", mVisibleObjects, mCulledObjects);
+      }
+      title += fmt::format(", {} binds ({} unsorted)", mRenderQueue.SortedStats().Total(),
+                           mRenderQueue.UnsortedStats().Total());
+      if (mGpuProfiler->Enabled()) {
+        title += fmt::format(", {:.3f}ms GPU", mGpuProfiler->LastFrameMs());
+      }
+      if (mWindow) {
+        mWindow->SetTitle(title);
+      } else {
+        Log::Info("[Run] {}", title);
+      }
+      recordMsAcc = 0.0f;
+      sampleCount = 0;
+    }
+
+    // When a capture is requested from the command line, capture the last frame of a limited run,
+    // or the very first frame of an unlimited one.
+    const uint64_t finalFrame{mFrameLimit > 0 ? mFrameLimit - 1 : 0};
+    if (!mFinalCapturePath.empty() && mCurrentFrame == finalFrame) {
+      CaptureFrame(mFinalCapturePath);
+    }
+
+    if (!mTracePath.empty() && mCurrentFrame == mTraceStart) {
+      Profiler::SetEnabled(true);
+    }
+
+    const uint64_t renderedFrames{mCurrentFrame};
+    Render();
+
+    if (!mTracePath.empty() && mTraceFrames > 0 && mCurrentFrame >= mTraceStart + mTraceFrames) {
+      FinishTrace();
+    }
+
+    mRunning = mWindow ? mWindow->Update() : true;
+    if (mFrameLimit > 0 && mCurrentFrame >= mFrameLimit) {
+      mRunning = false;
+    }
+
     auto endTime{std::chrono::high_resolution_clock::now()};
     auto deltaUs{
         std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count()};
     startTime = endTime;
-    auto deltaMs{deltaUs / 1000.0f};
-    msAcc += deltaMs;
+    // Only submitted frames are recorded. A minimized window or an out of date swapchain skips
+    // the frame, and would otherwise flood the statistics with empty ones.
+    if (mCurrentFrame == renderedFrames) {
+      mWaitMs = 0.0f;
+      continue;
+    }
+    // GPU times arrive frames in flight late, so they are attributed to the frame that resolved
+    // them.
+    const float gpuMs{mGpuProfiler->Enabled() ? mGpuProfiler->LastFrameMs()
+                                              : std::numeric_limits<float>::quiet_NaN()};
+    mFrameStats.AddFrame({deltaUs / 1000.0f, gpuMs, mWaitMs});
+    mWaitMs = 0.0f;
+    recordMsAcc += mRecordMs;
     sampleCount++;
 
-    if (msAcc > 1000.0f) {
-      const float msAvg{msAcc / sampleCount};
-      const std::string title{
-          fmt::format("Raven - {:.2f}ms ({} FPS)", msAvg, static_cast<uint32_t>(1000.0f / msAvg))};
-      mWindow->SetTitle(title);
-      msAcc = 0.0f;
-      sampleCount = 0;
+    // Warm-up frames settle caches and allocations, and are left out of benchmark results.
+    if (mBenchmarkInstances > 0 && mCurrentFrame == gBenchmarkWarmupFrames) {
+      mFrameStats.Reset();
+      mGpuProfiler->ResetStats();
     }
+  }
+}
 
-    Render();
-
-    mRunning = mWindow->Update();
+void Application::CaptureFrame(const std::string& path) {
+  if (!mHeadless) {
+    Log::Warn("[CaptureFrame] Frame capture is only supported in headless mode.");
+    return;
   }
+
+  mCaptureRequested = true;
+  mCapturePath = path;
 }
 
+const FrameCapture& Application::GetLastCapture() const noexcept { return mLastCapture; }
+
 /* ==========================================================================================
  * Private Application Methods
  * ========================================================================================== */
 
 void Application::Render() {
-  FrameData& frame{mFrames[mCurrentFrame % FRAME_OVERLAP]};
-
-  mDevice->waitForFences(*frame.RenderFence, true, std::numeric_limits<uint64_t>::max());
-  mDevice->resetFences(*frame.RenderFence);
+  RAVEN_PROFILE_SCOPE("Render");
+  const uint32_t frameIndex{static_cast<uint32_t>(mCurrentFrame % mFrames.size())};
+  FrameData& frame{mFrames[frameIndex]};
+  WaitForFrame(frame);
+  ReleaseRetiredSwapchains();
+  ReleaseRetiredBuffers();
+
+  // In headless mode we own the images, and each one is only ever used by the frame that shares
+  // its index, so the frame fence above is all the synchronization we need.
+  uint32_t imageIndex{static_cast<uint32_t>(mCurrentFrame % mSwapchain.ImageCount)};
+  if (!mHeadless) {
+    // A minimized window has nothing to render to. Window::Update sleeps until it is restored.
+    if (mWindow->Width() == 0 || mWindow->Height() == 0) {
+      return;
+    }
+    if (mSwapchainDirty || mWindow->Width() != mSwapchain.Extent.width ||
+        mWindow->Height() != mSwapchain.Extent.height) {
+      RecreateSwapchain();
+    }
 
-  uint32_t imageIndex{mDevice->acquireNextImageKHR(
-      *mSwapchain.Swapchain, std::numeric_limits<uint64_t>::max(), *frame.PresentSemaphore)};
+    // A suboptimal swapchain can still be presented to, so the frame goes ahead and the swapchain
+    // is rebuilt on the next one. An out of date swapchain cannot.
+    try {
+      const vk::ResultValue<uint32_t> acquired{mDevice->acquireNextImageKHR(
+          *mSwapchain.Swapchain, std::numeric_limits<uint64_t>::max(), *frame.PresentSemaphore)};
+      imageIndex = acquired.value;
+      if (acquired.result == vk::Result::eSuboptimalKHR) {
+        mSwapchainDirty = true;
+      }
+    } catch (const vk::OutOfDateKHRError&) {
+      mSwapchainDirty = true;
+      return;
+    }
+  }
 
   const vk::UniqueCommandBuffer& cmd{frame.MainCommandBuffer};
 
+  const auto recordStart{std::chrono::high_resolution_clock::now()};
   const vk::CommandBufferBeginInfo beginInfo;
   cmd->begin(beginInfo);
+  mGpuProfiler->BeginFrame(*cmd, frameIndex);
 
-  const std::array<float, 4> clearColor{0.0f, 0.0f, 1.0f, 1.0f};
-  const std::vector<vk::ClearValue> clearValues{vk::ClearColorValue(clearColor),
-                                                vk::ClearDepthStencilValue(1.0f, 0)};
-  const vk::RenderPassBeginInfo rpInfo(*mRenderPass, *mSwapchain.Framebuffers[imageIndex],
-                                       {{0, 0}, mSwapchain.Extent}, clearValues);
-  cmd->beginRenderPass(rpInfo, vk::SubpassContents::eInline);
-
-  const std::shared_ptr<Material> bgMat{GetMaterial("background")};
-  if (bgMat) {
-    cmd->bindPipeline(vk::PipelineBindPoint::eGraphics, bgMat->Pipeline.get()->get());
-    cmd->draw(3, 1, 0, 0);
+  ProcessPendingMeshes();
+  ProcessShaderChanges();
+  mPipelines->Update(mFrameTimelineValue, mDevice->getSemaphoreCounterValue(*mFrameTimeline));
+  if (mGpuCulling) {
+    UpdateCullScene(frame);
   }
 
-  const glm::vec3 camPos(0, 4, -10);
+  // Submit any uploads queued since the last frame. They run on the transfer queue in parallel,
+  // and this frame's submission waits for them on the GPU instead of the CPU.
+  mTransfer->Flush();
+  const uint64_t uploadValue{mTransfer->RecordAcquireBarriers(*cmd)};
+
+  glm::vec3 camPos(0, 4, -10);
+  if (mBenchmarkInstances > 0) {
+    // The benchmark camera orbits inside the grid once per run, bobbing up and down. It follows
+    // the frame number rather than wall time, so every run renders exactly the same frames.
+    const float gridRadius{std::ceil(std::sqrt(static_cast<float>(mBenchmarkInstances))) / 2.0f};
+    const float angle{glm::radians(360.0f * mCurrentFrame / mFrameLimit)};
+    camPos = glm::vec3(std::sin(angle) * gridRadius * 0.75f,
+                       2.0f + gridRadius * (0.25f + 0.15f * std::sin(angle * 3.0f)),
+                       -std::cos(angle) * gridRadius * 0.75f);
+  }
   const glm::mat4 view{glm::lookAt(camPos, glm::vec3(0), glm::vec3(0, 1, 0))};
   glm::mat4 proj{glm::perspective(
       glm::radians(70.0f),
@@ -414,76 +638,567 @@ void Application::Render() {
   const glm::mat4 viewProj{proj * view};
   const GlobalDescriptor_Camera global_Camera{view, proj, viewProj};
 
-  void* data{mDevice->mapMemory(frame.Global_CameraBuffer.Memory.get(), 0,
-                                frame.Global_CameraBuffer.Size)};
-  memcpy(data, &global_Camera, sizeof(global_Camera));
-  mDevice->unmapMemory(frame.Global_CameraBuffer.Memory.get());
-
-  GlobalPushConstants globalConstants;
-
-  std::shared_ptr<Material> lastMaterial;
-  std::shared_ptr<Mesh> lastMesh;
-  for (const auto& obj : mRenderables) {
-    if (obj.Material != lastMaterial) {
-      cmd->bindPipeline(vk::PipelineBindPoint::eGraphics, obj.Material->Pipeline.get()->get());
-      cmd->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, obj.Material->Layout.get()->get(),
-                              0, frame.GlobalSet, nullptr);
-      lastMaterial = obj.Material;
-    }
-    if (obj.Mesh != lastMesh) {
-      cmd->bindVertexBuffers(0, obj.Mesh->VertexBuffer.Handle.get(), vk::DeviceSize(0));
-      lastMesh = obj.Mesh;
-    }
+  // The frame's fence has been waited on, so everything allocated last time it was used is free.
+  frame.Uniforms.Reset();
+  frame.CameraOffset = frame.Uniforms.Push(global_Camera);
+
+  UpdateObjects(frame);
 
-    globalConstants.Model = obj.Transform;
-    cmd->pushConstants<GlobalPushConstants>(obj.Material->Layout.get()->get(),
-                                            vk::ShaderStageFlagBits::eVertex, 0, globalConstants);
-    cmd->draw(obj.Mesh->VertexCount, 1, 0, 0);
+  if (mGpuCulling) {
+    const GpuPass cullPass{mGpuProfiler->AddPass("Culling")};
+    cullPass.Begin(*cmd);
+    RecordCulling(cmd, frame, ExtractFrustum(viewProj));
+    cullPass.End(*cmd);
+  } else {
+    BuildBatches(frame, ExtractFrustum(viewProj), camPos);
   }
 
+  const std::array<float, 4> clearColor{0.0f, 0.0f, 1.0f, 1.0f};
+  const std::vector<vk::ClearValue> clearValues{vk::ClearColorValue(clearColor),
+                                                vk::ClearDepthStencilValue(1.0f, 0)};
+  const vk::RenderPassBeginInfo rpInfo(*mRenderPass, *mSwapchain.Framebuffers[imageIndex],
+                                       {{0, 0}, mSwapchain.Extent}, clearValues);
+
+  // With GPU culling, each batch's draw parameters come from the culling pass. Batches with no
+  // visible instances have a draw count of zero and are skipped by the GPU.
+  const std::vector<RenderBatch>& batches{mGpuCulling ? mCullBatches : mBatches};
+  const MaterialHandle backgroundMaterial{GetMaterial("background")};
+  const bool background{backgroundMaterial != InvalidHandle &&
+                        mScene.GetMaterial(backgroundMaterial).Ready()};
+  frame.BackgroundPass = background ? mGpuProfiler->AddPass("Background") : GpuPass{};
+  frame.OpaquePass = mGpuProfiler->AddPass("Opaque");
+
+  // Large batch lists are split into contiguous ranges, each recorded into its own secondary
+  // command buffer on a worker thread. Small ones are not worth the hand-off.
+  const uint32_t recordJobs{std::min(
+      mRecordThreads, static_cast<uint32_t>((batches.size() + gMinBatchesPerRecordJob - 1) /
+                                            gMinBatchesPerRecordJob))};
+  if (recordJobs <= 1) {
+    cmd->beginRenderPass(rpInfo, vk::SubpassContents::eInline);
+    RecordDraws(*cmd, frame, batches, 0, batches.size(), background);
+  } else {
+    cmd->beginRenderPass(rpInfo, vk::SubpassContents::eSecondaryCommandBuffers);
+
+    const vk::CommandBufferInheritanceInfo inheritance(*mRenderPass, 0,
+                                                       *mSwapchain.Framebuffers[imageIndex]);
+    mJobs->ParallelFor(recordJobs, [&](uint32_t job) {
+      mDevice->resetCommandPool(*frame.RecordPools[job]);
+
+      const vk::CommandBuffer secondary{frame.RecordCommandBuffers[job]};
+      const vk::CommandBufferBeginInfo secondaryBegin(
+          vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+              vk::CommandBufferUsageFlagBits::eRenderPassContinue,
+          &inheritance);
+      secondary.begin(secondaryBegin);
+      RecordDraws(secondary, frame, batches, batches.size() * job / recordJobs,
+                  batches.size() * (job + 1) / recordJobs, background && job == 0);
+      secondary.end();
+    });
+
+    cmd->executeCommands(recordJobs, frame.RecordCommandBuffers.data());
+  }
+  mDrawCalls = static_cast<uint32_t>(batches.size()) + (background ? 1 : 0);
+
   cmd->endRenderPass();
 
+  const bool capture{mCaptureRequested};
+  if (capture) {
+    RecordCapture(cmd, imageIndex);
+  }
+
+  mGpuProfiler->EndFrame(*cmd);
   cmd->end();
+  mRecordMs = std::chrono::duration<float, std::chrono::milliseconds::period>(
+                  std::chrono::high_resolution_clock::now() - recordStart)
+                  .count();
 
-  const std::vector<vk::Semaphore> waitSemaphores{*frame.PresentSemaphore};
-  const std::vector<vk::Semaphore> signalSemaphores{*frame.RenderSemaphore};
-  const std::vector<vk::PipelineStageFlags> waitStages{
-      vk::PipelineStageFlagBits::eColorAttachmentOutput};
   const std::vector<vk::CommandBuffer> cmdBuffers{*cmd};
-  const vk::SubmitInfo submitInfo(waitSemaphores, waitStages, cmdBuffers, signalSemaphores);
-  mGraphicsQueue.submit(submitInfo, *frame.RenderFence);
+  std::vector<vk::Semaphore> waitSemaphores{mTransfer->GetTimeline()};
+  std::vector<vk::PipelineStageFlags> waitStages{TransferManager::ConsumerStages};
+  std::vector<uint64_t> waitValues{uploadValue};
+  frame.TimelineValue = ++mFrameTimelineValue;
+  std::vector<vk::Semaphore> signalSemaphores{*mFrameTimeline};
+  std::vector<uint64_t> signalValues{frame.TimelineValue};
+  if (!mHeadless) {
+    waitSemaphores.push_back(*frame.PresentSemaphore);
+    waitStages.push_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+    waitValues.push_back(0);  // Ignored for binary semaphores.
+    signalSemaphores.push_back(*frame.RenderSemaphore);
+    signalValues.push_back(0);
+  }
+  const vk::TimelineSemaphoreSubmitInfo timelineInfo(waitValues, signalValues);
+  vk::SubmitInfo submitInfo(waitSemaphores, waitStages, cmdBuffers, signalSemaphores);
+  submitInfo.setPNext(&timelineInfo);
+  mGraphicsQueue.submit(submitInfo, nullptr);
+
+  if (!mHeadless) {
+    const vk::PresentInfoKHR presentInfo(*frame.RenderSemaphore, *mSwapchain.Swapchain,
+                                         imageIndex);
+    try {
+      if (mGraphicsQueue.presentKHR(presentInfo) == vk::Result::eSuboptimalKHR) {
+        mSwapchainDirty = true;
+      }
+    } catch (const vk::OutOfDateKHRError&) {
+      mSwapchainDirty = true;
+    }
+  }
 
-  const vk::PresentInfoKHR presentInfo(signalSemaphores, *mSwapchain.Swapchain, imageIndex);
-  mGraphicsQueue.presentKHR(presentInfo);
+  if (capture) {
+    ResolveCapture(frame);
+  }
 
   mCurrentFrame++;
 }
 
+void Application::RecordDraws(vk::CommandBuffer cmd, const FrameData& frame,
+                              const std::vector<RenderBatch>& batches, size_t first, size_t last,
+                              bool background) {
+  RAVEN_PROFILE_SCOPE("RecordDraws");
+  const vk::Viewport viewport(0.0f, 0.0f, static_cast<float>(mSwapchain.Extent.width),
+                              static_cast<float>(mSwapchain.Extent.height), 0.0f, 1.0f);
+  const vk::Rect2D scissor({0, 0}, mSwapchain.Extent);
+  cmd.setViewport(0, viewport);
+  cmd.setScissor(0, scissor);
+
+  if (background) {
+    frame.BackgroundPass.Begin(cmd);
+    cmd.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                     mScene.GetMaterial(GetMaterial("background")).Pipeline.get()->get());
+    cmd.draw(3, 1, 0, 0);
+    frame.BackgroundPass.End(cmd);
+  }
+  if (first == 0) {
+    frame.OpaquePass.Begin(cmd);
+  }
+
+  // State is not inherited between command buffers, so every range starts with a full bind.
+  vk::UniquePipeline* lastPipeline{nullptr};
+  Material* lastMaterial{nullptr};
+  Mesh* lastMesh{nullptr};
+  Material* placeholder{&mScene.GetMaterial(mPlaceholderMaterial)};
+  for (size_t i = first; i < last; i++) {
+    const RenderBatch& batch{batches[i]};
+    Material* material{batch.Material->Ready() ? batch.Material : placeholder};
+    if (material->Pipeline.get() != lastPipeline) {
+      cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, material->Pipeline.get()->get());
+      lastPipeline = material->Pipeline.get();
+    }
+    if (material != lastMaterial) {
+      cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, material->Layout.get()->get(), 0,
+                             frame.GlobalSet, frame.CameraOffset);
+      lastMaterial = material;
+    }
+    if (batch.Mesh != lastMesh) {
+      cmd.bindVertexBuffers(0, batch.Mesh->VertexBuffer.Handle.get(), vk::DeviceSize(0));
+      cmd.bindIndexBuffer(batch.Mesh->IndexBuffer.Handle.get(), 0, batch.Mesh->IndexType);
+      lastMesh = batch.Mesh;
+    }
+
+    if (mGpuCulling) {
+      cmd.drawIndexedIndirectCount(*frame.CullIndirectBuffer.Handle,
+                                   i * sizeof(vk::DrawIndexedIndirectCommand),
+                                   *frame.CullCountBuffer.Handle, i * sizeof(uint32_t), 1,
+                                   sizeof(vk::DrawIndexedIndirectCommand));
+    } else {
+      cmd.drawIndexed(batch.Mesh->IndexCount, batch.InstanceCount, 0, 0, batch.FirstInstance);
+    }
+  }
+  if (last == batches.size()) {
+    frame.OpaquePass.End(cmd);
+  }
+}
+
+void Application::UpdateObjects(FrameData& frame) {
+  RAVEN_PROFILE_SCOPE("UpdateObjects");
+  if (frame.ObjectVersion == mScene.Version()) {
+    return;
+  }
+
+  const uint32_t objectCount{static_cast<uint32_t>(mScene.ObjectCount())};
+  if (objectCount > frame.ObjectCapacity) {
+    // The frame's fence has already been waited on, so the old buffer is no longer in use.
+    uint32_t capacity{std::max(frame.ObjectCapacity, 1024u)};
+    while (capacity < objectCount) {
+      capacity *= 2;
+    }
+    frame.ObjectBuffer = CreateBuffer(
+        capacity * sizeof(ObjectData), vk::BufferUsageFlagBits::eStorageBuffer,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    frame.ObjectCapacity = capacity;
+    frame.ObjectVersion = 0;
+
+    const vk::DescriptorBufferInfo objectsInfo(*frame.ObjectBuffer.Handle, 0, VK_WHOLE_SIZE);
+    const std::vector<vk::WriteDescriptorSet> writes{
+        vk::WriteDescriptorSet(frame.GlobalSet, 1, 0, vk::DescriptorType::eStorageBuffer, nullptr,
+                               objectsInfo),
+        vk::WriteDescriptorSet(frame.CullSet, 4, 0, vk::DescriptorType::eStorageBuffer, nullptr,
+                               objectsInfo)};
+    mDevice->updateDescriptorSets(writes, nullptr);
+  }
+
+  const std::vector<glm::mat4>& transforms{mScene.Transforms()};
+  const std::vector<uint64_t>& versions{mScene.TransformVersions()};
+  ObjectData* objects{static_cast<ObjectData*>(frame.ObjectBuffer.Memory.Mapped)};
+  for (uint32_t i = 0; i < objectCount; i++) {
+    if (versions[i] > frame.ObjectVersion) {
+      objects[i].Model = transforms[i];
+    }
+  }
+  frame.ObjectVersion = mScene.Version();
+}
+
+void Application::BuildBatches(FrameData& frame, const Frustum& frustum,
+                               const glm::vec3& cameraPosition) {
+  RAVEN_PROFILE_SCOPE("BuildBatches");
+  // Meshes that are still streaming in are skipped.
+  const std::vector<glm::mat4>& transforms{mScene.Transforms()};
+  const std::vector<MeshHandle>& meshes{mScene.ObjectMeshes()};
+  const std::vector<MaterialHandle>& materials{mScene.ObjectMaterials()};
+  const std::vector<uint64_t>& keys{mScene.SortKeys()};
+  const uint32_t objectCount{static_cast<uint32_t>(mScene.ObjectCount())};
+
+  mCullCandidates.clear();
+  mCullBounds.Clear();
+  for (uint32_t i = 0; i < objectCount; i++) {
+    const Mesh& mesh{mScene.GetMesh(meshes[i])};
+    if (mesh.Ready) {
+      glm::vec3 center, extent;
+      TransformBounds(mesh.Bounds, transforms[i], center, extent);
+      mCullBounds.Push(center, extent);
+      mCullCandidates.push_back(i);
+    }
+  }
+
+  mCullVisibility.resize(mCullCandidates.size());
+  mVisibleObjects = static_cast<uint32_t>(CullAabbs(frustum, mCullBounds, mCullVisibility.data()));
+  mCulledObjects = static_cast<uint32_t>(mCullCandidates.size()) - mVisibleObjects;
+
+  // Objects are sorted by state and then front to back. Each run of equal state becomes a single
+  // instanced draw.
+  mRenderQueue.Clear();
+  for (size_t i = 0; i < mCullCandidates.size(); i++) {
+    if (mCullVisibility[i]) {
+      const uint32_t object{mCullCandidates[i]};
+      const float distance{glm::length(glm::vec3(transforms[object][3]) - cameraPosition)};
+      mRenderQueue.Push(keys[object] | QuantizeDepth(distance, 1000.0f), object);
+    }
+  }
+  mRenderQueue.Sort();
+
+  const std::vector<RenderQueue::Entry>& entries{mRenderQueue.Entries()};
+  const uint32_t instanceCount{static_cast<uint32_t>(entries.size())};
+  if (instanceCount > frame.InstanceCapacity) {
+    // The frame's fence has already been waited on, so the old buffer is no longer in use.
+    uint32_t capacity{std::max(frame.InstanceCapacity, 1024u)};
+    while (capacity < instanceCount) {
+      capacity *= 2;
+    }
+    frame.InstanceBuffer = CreateBuffer(
+        capacity * sizeof(uint32_t), vk::BufferUsageFlagBits::eStorageBuffer,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    frame.InstanceCapacity = capacity;
+
+    const vk::DescriptorBufferInfo instancesInfo(*frame.InstanceBuffer.Handle, 0, VK_WHOLE_SIZE);
+    const vk::WriteDescriptorSet instancesWrite(
+        frame.GlobalSet, 2, 0, vk::DescriptorType::eStorageBuffer, nullptr, instancesInfo);
+    mDevice->updateDescriptorSets(instancesWrite, nullptr);
+  }
+
+  uint32_t* instances{static_cast<uint32_t*>(frame.InstanceBuffer.Memory.Mapped)};
+  mBatches.clear();
+  uint64_t lastState{std::numeric_limits<uint64_t>::max()};
+  for (uint32_t i = 0; i < instanceCount; i++) {
+    const uint32_t object{entries[i].Object};
+    instances[i] = object;
+
+    if (GetStateKey(entries[i].Key) != lastState) {
+      mBatches.push_back({&mScene.GetMesh(meshes[object]),
+                          &mScene.GetMaterial(materials[object]), i, 0});
+      lastState = GetStateKey(entries[i].Key);
+    }
+    mBatches.back().InstanceCount++;
+  }
+}
+
+void Application::UpdateCullScene(FrameData& frame) {
+  RAVEN_PROFILE_SCOPE("UpdateCullScene");
+  // Transforms are read from each frame's object buffer, so moving objects does not require a
+  // rebuild.
+  if (mCullSceneDirty || mCullSceneObjects != mScene.ObjectCount()) {
+    RebuildCullScene();
+  }
+  if (frame.CullSceneVersion == mCullSceneVersion || mCullObjectCount == 0) {
+    return;
+  }
+  frame.CullSceneVersion = mCullSceneVersion;
+
+  // This frame's previous submission has completed, so its own buffers and descriptor sets are
+  // free to replace. Other frames in flight catch up the next time they are used.
+  const size_t drawCount{mCullBatches.size()};
+  const vk::DeviceSize drawsSize{drawCount * sizeof(vk::DrawIndexedIndirectCommand)};
+  const vk::DeviceSize countsSize{drawCount * sizeof(uint32_t)};
+  const vk::DeviceSize instancesSize{mCullObjectCount * sizeof(uint32_t)};
+  frame.CullIndirectBuffer = CreateBuffer(drawsSize,
+                                          vk::BufferUsageFlagBits::eIndirectBuffer |
+                                              vk::BufferUsageFlagBits::eStorageBuffer |
+                                              vk::BufferUsageFlagBits::eTransferDst,
+                                          vk::MemoryPropertyFlagBits::eDeviceLocal);
+  frame.CullCountBuffer = CreateBuffer(countsSize,
+                                       vk::BufferUsageFlagBits::eIndirectBuffer |
+                                           vk::BufferUsageFlagBits::eStorageBuffer |
+                                           vk::BufferUsageFlagBits::eTransferDst,
+                                       vk::MemoryPropertyFlagBits::eDeviceLocal);
+  frame.CullInstanceBuffer = CreateBuffer(instancesSize, vk::BufferUsageFlagBits::eStorageBuffer,
+                                          vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+  const vk::DescriptorBufferInfo objectsInfo(*mCullObjects.Handle, 0, VK_WHOLE_SIZE);
+  const vk::DescriptorBufferInfo drawsInfo(*frame.CullIndirectBuffer.Handle, 0, VK_WHOLE_SIZE);
+  const vk::DescriptorBufferInfo countsInfo(*frame.CullCountBuffer.Handle, 0, VK_WHOLE_SIZE);
+  const vk::DescriptorBufferInfo instancesInfo(*frame.CullInstanceBuffer.Handle, 0,
+                                               VK_WHOLE_SIZE);
+  const std::vector<vk::WriteDescriptorSet> writes{
+      vk::WriteDescriptorSet(frame.CullSet, 0, 0, vk::DescriptorType::eStorageBuffer, nullptr,
+                             objectsInfo),
+      vk::WriteDescriptorSet(frame.CullSet, 1, 0, vk::DescriptorType::eStorageBuffer, nullptr,
+                             drawsInfo),
+      vk::WriteDescriptorSet(frame.CullSet, 2, 0, vk::DescriptorType::eStorageBuffer, nullptr,
+                             countsInfo),
+      vk::WriteDescriptorSet(frame.CullSet, 3, 0, vk::DescriptorType::eStorageBuffer, nullptr,
+                             instancesInfo),
+      vk::WriteDescriptorSet(frame.GlobalSet, 2, 0, vk::DescriptorType::eStorageBuffer, nullptr,
+                             instancesInfo)};
+  mDevice->updateDescriptorSets(writes, nullptr);
+}
+
+void Application::RebuildCullScene() {
+  RAVEN_PROFILE_SCOPE("RebuildCullScene");
+  mCullSceneDirty = false;
+  mCullSceneObjects = mScene.ObjectCount();
+  mCullSceneVersion++;
+
+  // Frames in flight may still read the old shared buffers, so rather than waiting for the device
+  // to idle they are retired and destroyed once those frames have completed.
+  RetiredBuffers& retired{mRetiredBuffers.emplace_back()};
+  retired.TimelineValue = mFrameTimelineValue;
+  retired.Buffers.push_back(std::move(mCullObjects));
+  retired.Buffers.push_back(std::move(mCullDrawTemplate));
+  mCullObjects = Buffer{};
+  mCullDrawTemplate = Buffer{};
+
+  const std::vector<MeshHandle>& meshes{mScene.ObjectMeshes()};
+  const std::vector<MaterialHandle>& materials{mScene.ObjectMaterials()};
+  const std::vector<uint64_t>& keys{mScene.SortKeys()};
+
+  // Depth is left out of the keys here, as the order is fixed until the scene changes.
+  mRenderQueue.Clear();
+  for (uint32_t i = 0; i < mScene.ObjectCount(); i++) {
+    if (mScene.GetMesh(meshes[i]).Ready) {
+      mRenderQueue.Push(keys[i], i);
+    }
+  }
+  mRenderQueue.Sort();
+  const std::vector<RenderQueue::Entry>& entries{mRenderQueue.Entries()};
+  mCullObjectCount = static_cast<uint32_t>(entries.size());
+  mCullBatches.clear();
+  if (mCullObjectCount == 0) {
+    return;
+  }
+
+  std::vector<CullObject> objects(mCullObjectCount);
+  std::vector<vk::DrawIndexedIndirectCommand> draws;
+  uint64_t lastKey{std::numeric_limits<uint64_t>::max()};
+  for (uint32_t i = 0; i < mCullObjectCount; i++) {
+    const uint32_t object{entries[i].Object};
+    Mesh& mesh{mScene.GetMesh(meshes[object])};
+    if (keys[object] != lastKey) {
+      mCullBatches.push_back({&mesh, &mScene.GetMaterial(materials[object]), i, 0});
+      draws.emplace_back(mesh.IndexCount, 0, 0, 0, i);
+      lastKey = keys[object];
+    }
+    mCullBatches.back().InstanceCount++;
+
+    objects[i].BoundsMin = glm::vec4(mesh.Bounds.Min, 0.0f);
+    objects[i].BoundsMax = mesh.Bounds.Max;
+    objects[i].Batch = static_cast<uint32_t>(mCullBatches.size() - 1);
+    objects[i].Object = object;
+  }
+
+  const vk::DeviceSize objectsSize{objects.size() * sizeof(CullObject)};
+  const vk::DeviceSize drawsSize{draws.size() * sizeof(vk::DrawIndexedIndirectCommand)};
+
+  mCullObjects = CreateBuffer(
+      objectsSize, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+      vk::MemoryPropertyFlagBits::eDeviceLocal);
+  mTransfer->Upload(mCullObjects, objects.data(), objectsSize);
+  // Draw commands are reset from this template at the start of every culling pass.
+  mCullDrawTemplate = CreateBuffer(
+      drawsSize, vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
+      vk::MemoryPropertyFlagBits::eDeviceLocal);
+  mTransfer->Upload(mCullDrawTemplate, draws.data(), drawsSize);
+
+  Log::Debug("[RebuildCullScene] {} objects in {} batches.", mCullObjectCount,
+             mCullBatches.size());
+}
+
+void Application::RecordCulling(const vk::UniqueCommandBuffer& cmd, FrameData& frame,
+                                const Frustum& frustum) {
+  RAVEN_PROFILE_SCOPE("RecordCulling");
+  if (mCullObjectCount == 0) {
+    return;
+  }
+
+  const vk::BufferCopy drawsRegion(0, 0, mCullDrawTemplate.Size);
+  cmd->copyBuffer(*mCullDrawTemplate.Handle, *frame.CullIndirectBuffer.Handle, drawsRegion);
+  cmd->fillBuffer(*frame.CullCountBuffer.Handle, 0, VK_WHOLE_SIZE, 0);
+
+  const vk::MemoryBarrier resetBarrier(vk::AccessFlagBits::eTransferWrite,
+                                       vk::AccessFlagBits::eShaderRead |
+                                           vk::AccessFlagBits::eShaderWrite);
+  cmd->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                       vk::PipelineStageFlagBits::eComputeShader, {}, resetBarrier, nullptr,
+                       nullptr);
+
+  CullPushConstants constants;
+  for (size_t i = 0; i < frustum.Planes.size(); i++) {
+    constants.Planes[i] = frustum.Planes[i];
+  }
+  constants.ObjectCount = mCullObjectCount;
+
+  cmd->bindPipeline(vk::PipelineBindPoint::eCompute, **mCullPipeline);
+  cmd->bindDescriptorSets(vk::PipelineBindPoint::eCompute, *mCullPipelineLayout, 0, frame.CullSet,
+                          nullptr);
+  cmd->pushConstants<CullPushConstants>(*mCullPipelineLayout, vk::ShaderStageFlagBits::eCompute, 0,
+                                        constants);
+  cmd->dispatch((mCullObjectCount + 63) / 64, 1, 1);
+
+  const vk::MemoryBarrier cullBarrier(
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eShaderRead);
+  cmd->pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                       vk::PipelineStageFlagBits::eDrawIndirect |
+                           vk::PipelineStageFlagBits::eVertexShader,
+                       {}, cullBarrier, nullptr, nullptr);
+}
+
+void Application::RecordCapture(const vk::UniqueCommandBuffer& cmd, uint32_t imageIndex) {
+  const vk::DeviceSize size{static_cast<vk::DeviceSize>(mSwapchain.Extent.width) *
+                            mSwapchain.Extent.height * 4};
+  if (!mReadbackBuffer.Handle || mReadbackBuffer.Size < size) {
+    mReadbackBuffer = CreateBuffer(
+        size, vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+  }
+
+  const vk::Image image{mSwapchain.Images[imageIndex]};
+  const vk::ImageMemoryBarrier imageBarrier(
+      vk::AccessFlagBits::eColorAttachmentWrite, vk::AccessFlagBits::eTransferRead,
+      vk::ImageLayout::eTransferSrcOptimal, vk::ImageLayout::eTransferSrcOptimal,
+      VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, image,
+      vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1));
+  cmd->pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                       vk::PipelineStageFlagBits::eTransfer, {}, nullptr, nullptr, imageBarrier);
+
+  const vk::BufferImageCopy region(
+      0, 0, 0, vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1), {0, 0, 0},
+      vk::Extent3D(mSwapchain.Extent, 1));
+  cmd->copyImageToBuffer(image, vk::ImageLayout::eTransferSrcOptimal, *mReadbackBuffer.Handle,
+                         region);
+
+  const vk::BufferMemoryBarrier bufferBarrier(
+      vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eHostRead, VK_QUEUE_FAMILY_IGNORED,
+      VK_QUEUE_FAMILY_IGNORED, *mReadbackBuffer.Handle, 0, size);
+  cmd->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {},
+                       nullptr, bufferBarrier, nullptr);
+}
+
+void Application::ResolveCapture(const FrameData& frame) {
+  RAVEN_PROFILE_SCOPE("ResolveCapture");
+  // Captures are explicitly requested, so stalling here for the result is acceptable.
+  WaitForFrame(frame);
+
+  mLastCapture.Width = mSwapchain.Extent.width;
+  mLastCapture.Height = mSwapchain.Extent.height;
+  mLastCapture.Frame = mCurrentFrame;
+  mLastCapture.Pixels.resize(static_cast<size_t>(mLastCapture.Width) * mLastCapture.Height * 4);
+
+  memcpy(mLastCapture.Pixels.data(), mReadbackBuffer.Memory.Mapped, mLastCapture.Pixels.size());
+
+  if (!mCapturePath.empty()) {
+    const int written{stbi_write_png(mCapturePath.c_str(), mLastCapture.Width,
+                                     mLastCapture.Height, 4, mLastCapture.Pixels.data(),
+                                     mLastCapture.Width * 4)};
+    if (written) {
+      Log::Info("[ResolveCapture] Frame {} written to {}", mCurrentFrame, mCapturePath);
+    } else {
+      Log::Error("[ResolveCapture] Failed to write frame capture to {}", mCapturePath);
+    }
+  }
+
+  mCaptureRequested = false;
+  mCapturePath.clear();
+}
+
 /* ==========================================================================================
  * Application/Vulkan Setup
  * ========================================================================================== */
 
+void Application::WaitForFrame(const FrameData& frame) {
+  RAVEN_PROFILE_SCOPE("WaitForFrame");
+  const auto waitStart{std::chrono::high_resolution_clock::now()};
+  // Never block indefinitely without saying so. A frame that takes this long means the GPU is hung
+  // or heavily oversubscribed.
+  constexpr uint64_t timeoutNs{1000ull * 1000 * 1000};
+  const vk::SemaphoreWaitInfo waitInfo({}, *mFrameTimeline, frame.TimelineValue);
+  while (mDevice->waitSemaphores(waitInfo, timeoutNs) == vk::Result::eTimeout) {
+    Log::Warn("[WaitForFrame] Still waiting for frame timeline value {}.", frame.TimelineValue);
+  }
+  mWaitMs += std::chrono::duration<float, std::chrono::milliseconds::period>(
+                 std::chrono::high_resolution_clock::now() - waitStart)
+                 .count();
+}
+
+void Application::FinishTrace() {
+  Profiler::SetEnabled(false);
+  Profiler::WriteTrace(mTracePath);
+  mTracePath.clear();
+}
+
 void Application::InitializeVulkan() {
+  RAVEN_PROFILE_SCOPE("InitializeVulkan");
   PFN_vkGetInstanceProcAddr loader{
       mDynamicLoader.getProcAddress<PFN_vkGetInstanceProcAddr>("vkGetInstanceProcAddr")};
   VULKAN_HPP_DEFAULT_DISPATCHER.init(loader);
 
   InstanceBuilder builder;
-  builder.SetAppName("Raven").SetAppVersion(1, 0).SetApiVersion(1, 2).RequestValidation(
-      mValidation);
+  builder.SetAppName("Raven")
+      .SetAppVersion(1, 0)
+      .SetApiVersion(1, 2)
+      .RequestValidation(mValidation)
+      .RequireSurface(!mHeadless);
   const vk::InstanceCreateInfo instanceCI{builder};
-  const vk::StructureChain<vk::InstanceCreateInfo, vk::DebugUtilsMessengerCreateInfoEXT>
-      instanceChainCI{instanceCI, gDebugMessengerCI};
-  mInstance = vk::createInstanceUnique(instanceChainCI.get());
+  // Software drivers on headless build machines often ship without the validation layers, so only
+  // chain the debug messenger when validation could actually be enabled.
+  mValidation = builder.ValidationEnabled();
+  if (mValidation) {
+    const vk::StructureChain<vk::InstanceCreateInfo, vk::DebugUtilsMessengerCreateInfoEXT>
+        instanceChainCI{instanceCI, gDebugMessengerCI};
+    mInstance = vk::createInstanceUnique(instanceChainCI.get());
+  } else {
+    mInstance = vk::createInstanceUnique(instanceCI);
+  }
   Log::Debug("[InitializeVulkan] Vulkan Instance created.");
   VULKAN_HPP_DEFAULT_DISPATCHER.init(*mInstance);
 
-  mDebugMessenger = mInstance->createDebugUtilsMessengerEXTUnique(gDebugMessengerCI);
-  Log::Debug("[InitializeVulkan] Vulkan Debugger created. <{}>",
-             static_cast<void*>(*mDebugMessenger));
+  if (mValidation) {
+    mDebugMessenger = mInstance->createDebugUtilsMessengerEXTUnique(gDebugMessengerCI);
+    Log::Debug("[InitializeVulkan] Vulkan Debugger created. <{}>",
+               static_cast<void*>(*mDebugMessenger));
+  }
 
-  mSurface = mWindow->CreateSurface(*mInstance);
-  Log::Debug("[InitializeVulkan] Vulkan Surface created. <{}>", static_cast<void*>(*mSurface));
+  if (!mHeadless) {
+    mSurface = mWindow->CreateSurface(*mInstance);
+    Log::Debug("[InitializeVulkan] Vulkan Surface created. <{}>", static_cast<void*>(*mSurface));
+  }
 
   SelectPhysicalDevice();
   Log::Debug("[InitializeVulkan] Selected physical device: {}", mDeviceInfo.Properties.deviceName);
@@ -492,12 +1207,24 @@ void Application::InitializeVulkan() {
   Log::Debug("[InitializeVulkan] Vulkan Device created. <{}>", static_cast<void*>(*mDevice));
   VULKAN_HPP_DEFAULT_DISPATCHER.init(*mDevice);
 
+  mAllocator = std::make_unique<DeviceAllocator>(*mDevice, mDeviceInfo.MemoryProperties);
+
   GetQueues();
   Log::Debug("[InitializeVulkan] Device queues retrieved.");
 
-  CreateSwapchain();
-  Log::Debug("[InitializeVulkan] Vulkan Swapchain created with {} images. <{}>",
-             mSwapchain.ImageCount, static_cast<void*>(*mSwapchain.Swapchain));
+  mTransfer = std::make_unique<TransferManager>(*mDevice, *mAllocator, mTransferQueue,
+                                                mDeviceInfo.TransferIndex.value(),
+                                                mDeviceInfo.GraphicsIndex.value());
+
+  if (mHeadless) {
+    CreateOffscreenTargets();
+    Log::Debug("[InitializeVulkan] Offscreen render targets created with {} images.",
+               mSwapchain.ImageCount);
+  } else {
+    CreateSwapchain();
+    Log::Debug("[InitializeVulkan] Vulkan Swapchain created with {} images. <{}>",
+               mSwapchain.ImageCount, static_cast<void*>(*mSwapchain.Swapchain));
+  }
 
   CreateRenderPass();
   Log::Debug("[InitializeVulkan] Vulkan Render Pass created. <{}>",
@@ -508,8 +1235,19 @@ void Application::InitializeVulkan() {
 
   CreateDescriptors();
 
+  mPipelineCache =
+      std::make_unique<PipelineCache>(*mDevice, mDeviceInfo.Properties, gPipelineCachePath);
+  mPipelines = std::make_unique<PipelineRegistry>(*mDevice, mPipelineCache->Get(), *mJobs);
+  const auto pipelineStart{std::chrono::high_resolution_clock::now()};
   CreatePipeline();
-  Log::Debug("[InitializeVulkan] Vulkan Pipeline created. <{}>", static_cast<void*>(*mBgPipeline));
+  const float pipelineMs{std::chrono::duration<float, std::chrono::milliseconds::period>(
+                             std::chrono::high_resolution_clock::now() - pipelineStart)
+                             .count()};
+  Log::Debug("[InitializeVulkan] {} Vulkan Pipelines registered.", mPipelines->PipelineCount());
+  Log::Info("[InitializeVulkan] Pipelines created in {:.2f}ms from a {} pipeline cache ({} bytes).",
+            pipelineMs, mPipelineCache->Warm() ? "warm" : "cold", mPipelineCache->LoadedSize());
+  Log::Debug("[InitializeVulkan] {} pipelines still compiling in the background.",
+             mPipelines->PendingCount());
 
   CreateCommandPools();
   Log::Debug("[InitializeVulkan] Vulkan Command Pools created.");
@@ -520,12 +1258,44 @@ void Application::InitializeVulkan() {
   CreateSyncObjects();
   Log::Debug("[InitializeVulkan] Vulkan Sync Objects created.");
 
+  // A benchmark keeps every measured frame, so per-pass times cover the same frames as the rest of
+  // its report.
+  size_t gpuHistory{512};
+  if (mBenchmarkInstances > 0) {
+    gpuHistory = std::max<size_t>(gpuHistory, mFrameLimit - gBenchmarkWarmupFrames);
+  }
+  mGpuProfiler = std::make_unique<GpuProfiler>(
+      *mDevice, mDeviceInfo.Properties.limits.timestampPeriod,
+      mDeviceInfo.QueueFamilies[mDeviceInfo.GraphicsIndex.value()].Properties.timestampValidBits,
+      static_cast<uint32_t>(mFrames.size()), gpuHistory);
+
   CreateScene();
+
+#ifdef RAVEN_SHADER_SOURCE_DIR
+  mShaderWatcher = std::make_unique<FileWatcher>(RAVEN_SHADER_SOURCE_DIR);
+  if (*mShaderWatcher) {
+    Log::Info("[InitializeVulkan] Watching {} for shader changes.", RAVEN_SHADER_SOURCE_DIR);
+  } else {
+    mShaderWatcher.reset();
+  }
+#endif
 }
 
-void Application::ShutdownVulkan() { mDevice->waitIdle(); }
+void Application::ShutdownVulkan() {
+  RAVEN_PROFILE_SCOPE("ShutdownVulkan");
+  // Finish any in-flight loads before the resources they complete into are destroyed.
+  mJobs->WaitIdle();
+  mDevice->waitIdle();
+  mAllocator->LogStats();
+  mGpuProfiler->LogStats();
+
+  if (!mPipelineCache->Save()) {
+    Log::Warn("[ShutdownVulkan] Failed to write pipeline cache to {}.", gPipelineCachePath);
+  }
+}
 
 void Application::SelectPhysicalDevice() {
+  RAVEN_PROFILE_SCOPE("SelectPhysicalDevice");
   const std::vector<vk::PhysicalDevice> physicalDevices{mInstance->enumeratePhysicalDevices()};
   const size_t physicalDeviceCount{physicalDevices.size()};
 
@@ -543,9 +1313,17 @@ void Application::SelectPhysicalDevice() {
     {
       // Standard device info
       info.Features = device.getFeatures();
+      {
+        const auto features{
+            device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>()};
+        info.Features12 = features.get<vk::PhysicalDeviceVulkan12Features>();
+        info.Features12.pNext = nullptr;
+      }
       info.MemoryProperties = device.getMemoryProperties();
       info.Properties = device.getProperties();
-      info.SurfaceCapabilities = device.getSurfaceCapabilitiesKHR(*mSurface);
+      if (!mHeadless) {
+        info.SurfaceCapabilities = device.getSurfaceCapabilitiesKHR(*mSurface);
+      }
       info.Extensions = device.enumerateDeviceExtensionProperties();
 
       // Queue families
@@ -558,7 +1336,7 @@ void Application::SelectPhysicalDevice() {
           QueueFamilyInfo& q{info.QueueFamilies[i]};
           q.Index = i;
           q.Properties = queueFamilies[i];
-          q.PresentSupport = device.getSurfaceSupportKHR(i, *mSurface);
+          q.PresentSupport = mHeadless ? false : device.getSurfaceSupportKHR(i, *mSurface);
         }
       }
 
@@ -610,7 +1388,10 @@ void Application::SelectPhysicalDevice() {
       }
 
       // Determine Swapchain info
-      {
+      if (mHeadless) {
+        // Offscreen targets are read back as RGBA8, so render directly in that format.
+        info.OptimalSwapchainFormat.format = vk::Format::eR8G8B8A8Unorm;
+      } else {
         const auto formats{device.getSurfaceFormatsKHR(*mSurface)};
         const size_t formatCount{formats.size()};
 
@@ -751,6 +1532,12 @@ void Application::SelectPhysicalDevice() {
 
     // Score device
     {
+      if (!info.GraphicsIndex.has_value() || (!mHeadless && !info.PresentIndex.has_value())) {
+        continue;
+      }
+      if (!info.Features12.timelineSemaphore) {
+        continue;
+      }
       if (info.Properties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu) {
         score += 10000;
       }
@@ -777,9 +1564,12 @@ void Application::SelectPhysicalDevice() {
 }
 
 void Application::CreateDevice() {
+  RAVEN_PROFILE_SCOPE("CreateDevice");
   std::set<uint32_t> queueIndices{mDeviceInfo.GraphicsIndex.value(),
-                                  mDeviceInfo.PresentIndex.value(),
                                   mDeviceInfo.TransferIndex.value()};
+  if (mDeviceInfo.PresentIndex.has_value()) {
+    queueIndices.insert(mDeviceInfo.PresentIndex.value());
+  }
   if (mDeviceInfo.ComputeIndex.has_value()) {
     queueIndices.insert(mDeviceInfo.ComputeIndex.value());
   }
@@ -791,11 +1581,29 @@ void Application::CreateDevice() {
     queueCIs[i++] = vk::DeviceQueueCreateInfo({}, idx, 1, &priority);
   }
 
-  std::vector<const char*> deviceExtensions{VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+  std::vector<const char*> deviceExtensions;
+  if (!mHeadless) {
+    deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+  }
 
   vk::PhysicalDeviceFeatures requiredFeatures{};
+  vk::PhysicalDeviceVulkan12Features requiredFeatures12{};
+  requiredFeatures12.timelineSemaphore = true;
+
+  if (mGpuCulling) {
+    if (mDeviceInfo.Features12.drawIndirectCount &&
+        mDeviceInfo.Features.drawIndirectFirstInstance) {
+      requiredFeatures.drawIndirectFirstInstance = true;
+      requiredFeatures12.drawIndirectCount = true;
+    } else {
+      Log::Warn("[CreateDevice] GPU culling requires drawIndirectCount and "
+                "drawIndirectFirstInstance, falling back to CPU batching.");
+      mGpuCulling = false;
+    }
+  }
 
-  const vk::DeviceCreateInfo deviceCI({}, queueCIs, {}, deviceExtensions, &requiredFeatures);
+  const vk::StructureChain<vk::DeviceCreateInfo, vk::PhysicalDeviceVulkan12Features> deviceCI{
+      {{}, queueCIs, {}, deviceExtensions, &requiredFeatures}, requiredFeatures12};
 
   // Dump Instance Information
   {
@@ -807,17 +1615,19 @@ void Application::CreateDevice() {
     }
   }
 
-  mDevice = mPhysicalDevice.createDeviceUnique(deviceCI);
+  mDevice = mPhysicalDevice.createDeviceUnique(deviceCI.get());
 }
 
 void Application::GetQueues() noexcept {
   std::set<uint32_t> queueIndices{mDeviceInfo.GraphicsIndex.value(),
-                                  mDeviceInfo.PresentIndex.value(),
                                   mDeviceInfo.TransferIndex.value()};
 
   mGraphicsQueue = mDevice->getQueue(mDeviceInfo.GraphicsIndex.value(), 0);
   mTransferQueue = mDevice->getQueue(mDeviceInfo.TransferIndex.value(), 0);
-  mPresentQueue = mDevice->getQueue(mDeviceInfo.PresentIndex.value(), 0);
+  if (mDeviceInfo.PresentIndex.has_value()) {
+    mPresentQueue = mDevice->getQueue(mDeviceInfo.PresentIndex.value(), 0);
+    queueIndices.insert(mDeviceInfo.PresentIndex.value());
+  }
   if (mDeviceInfo.ComputeIndex.has_value()) {
     mComputeQueue = mDevice->getQueue(mDeviceInfo.ComputeIndex.value(), 0);
     queueIndices.insert(mDeviceInfo.ComputeIndex.value());
@@ -855,10 +1665,19 @@ void Application::GetQueues() noexcept {
   //}
 }
 
-void Application::CreateSwapchain() {
-  mSwapchain.ImageCount = std::min(mDeviceInfo.SurfaceCapabilities.minImageCount + 1,
-                                   mDeviceInfo.SurfaceCapabilities.maxImageCount);
+void Application::CreateSwapchain(vk::SwapchainKHR oldSwapchain) {
+  RAVEN_PROFILE_SCOPE("CreateSwapchain");
+  mSwapchain.ImageCount = mDeviceInfo.SurfaceCapabilities.minImageCount + 1;
+  if (mDeviceInfo.SurfaceCapabilities.maxImageCount > 0) {
+    mSwapchain.ImageCount =
+        std::min(mSwapchain.ImageCount, mDeviceInfo.SurfaceCapabilities.maxImageCount);
+  }
   mSwapchain.Extent = vk::Extent2D(mWindow->Width(), mWindow->Height());
+  // Most platforms dictate the extent, and only leave it up to us when it is 0xFFFFFFFF.
+  if (mDeviceInfo.SurfaceCapabilities.currentExtent.width !=
+      std::numeric_limits<uint32_t>::max()) {
+    mSwapchain.Extent = mDeviceInfo.SurfaceCapabilities.currentExtent;
+  }
 
   vk::SharingMode sharing{vk::SharingMode::eExclusive};
   std::vector<uint32_t> queues{mDeviceInfo.GraphicsIndex.value()};
@@ -890,11 +1709,12 @@ void Application::CreateSwapchain() {
       {}, *mSurface, mSwapchain.ImageCount, mDeviceInfo.OptimalSwapchainFormat.format,
       mDeviceInfo.OptimalSwapchainFormat.colorSpace, mSwapchain.Extent, 1,
       vk::ImageUsageFlagBits::eColorAttachment, sharing, queues, preTransform, compositeAlpha,
-      mDeviceInfo.OptimalPresentMode, true);
+      mDeviceInfo.OptimalPresentMode, true, oldSwapchain);
 
   mSwapchain.Swapchain = mDevice->createSwapchainKHRUnique(swapchainCI);
 
   mSwapchain.Images = mDevice->getSwapchainImagesKHR(*mSwapchain.Swapchain);
+  mSwapchain.ImageCount = static_cast<uint32_t>(mSwapchain.Images.size());
   mSwapchain.ImageViews.resize(mSwapchain.Images.size());
 
   for (size_t i = 0; i < mSwapchain.Images.size(); i++) {
@@ -903,7 +1723,83 @@ void Application::CreateSwapchain() {
         vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1));
     mSwapchain.ImageViews[i] = mDevice->createImageViewUnique(imageViewCI);
   }
+  mSwapchain.Format = swapchainCI.imageFormat;
+
+  CreateDepthBuffer();
+}
 
+void Application::RecreateSwapchain() {
+  RAVEN_PROFILE_SCOPE("RecreateSwapchain");
+  mDeviceInfo.SurfaceCapabilities = mPhysicalDevice.getSurfaceCapabilitiesKHR(*mSurface);
+
+  // Frames still in flight may be using the old swapchain's images, so rather than waiting for the
+  // device to idle, its resources are retired and destroyed once those frames have completed.
+  // Pipelines use dynamic viewport and scissor state, and the render pass only depends on the
+  // format, so neither has to be rebuilt.
+  mRetiredSwapchains.push_back({mFrameTimelineValue, std::move(mSwapchain)});
+  mSwapchain = VulkanSwapchain{};
+  CreateSwapchain(*mRetiredSwapchains.back().Swapchain.Swapchain);
+  CreateFramebuffers();
+  mSwapchainDirty = false;
+
+  Log::Debug("[RecreateSwapchain] Swapchain recreated at {}x{} with {} images.",
+             mSwapchain.Extent.width, mSwapchain.Extent.height, mSwapchain.ImageCount);
+}
+
+void Application::ReleaseRetiredSwapchains() {
+  if (mRetiredSwapchains.empty()) {
+    return;
+  }
+
+  const uint64_t completed{mDevice->getSemaphoreCounterValue(*mFrameTimeline)};
+  while (!mRetiredSwapchains.empty() && mRetiredSwapchains.front().TimelineValue <= completed) {
+    mRetiredSwapchains.pop_front();
+  }
+}
+
+void Application::ReleaseRetiredBuffers() {
+  if (mRetiredBuffers.empty()) {
+    return;
+  }
+
+  const uint64_t completed{mDevice->getSemaphoreCounterValue(*mFrameTimeline)};
+  while (!mRetiredBuffers.empty() && mRetiredBuffers.front().TimelineValue <= completed) {
+    mRetiredBuffers.pop_front();
+  }
+}
+
+void Application::CreateOffscreenTargets() {
+  RAVEN_PROFILE_SCOPE("CreateOffscreenTargets");
+  mSwapchain.ImageCount = static_cast<uint32_t>(mFrames.size());
+  mSwapchain.Extent = mHeadlessExtent;
+  mSwapchain.Format = mDeviceInfo.OptimalSwapchainFormat.format;
+
+  mSwapchain.OffscreenImages.resize(mSwapchain.ImageCount);
+  mSwapchain.OffscreenMemory.resize(mSwapchain.ImageCount);
+  mSwapchain.Images.resize(mSwapchain.ImageCount);
+  mSwapchain.ImageViews.resize(mSwapchain.ImageCount);
+
+  for (uint32_t i = 0; i < mSwapchain.ImageCount; i++) {
+    const vk::ImageCreateInfo imageCI(
+        {}, vk::ImageType::e2D, mSwapchain.Format, vk::Extent3D(mSwapchain.Extent, 1), 1, 1,
+        vk::SampleCountFlagBits::e1, vk::ImageTiling::eOptimal,
+        vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+        vk::SharingMode::eExclusive);
+    mSwapchain.OffscreenImages[i] = mDevice->createImageUnique(imageCI);
+    mSwapchain.Images[i] = *mSwapchain.OffscreenImages[i];
+    mSwapchain.OffscreenMemory[i] = mAllocator->AllocateImage(
+        *mSwapchain.OffscreenImages[i], vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+    const vk::ImageViewCreateInfo imageViewCI(
+        {}, mSwapchain.Images[i], vk::ImageViewType::e2D, mSwapchain.Format, {},
+        vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1));
+    mSwapchain.ImageViews[i] = mDevice->createImageViewUnique(imageViewCI);
+  }
+
+  CreateDepthBuffer();
+}
+
+void Application::CreateDepthBuffer() {
   const std::vector<vk::Format> depthFormats{vk::Format::eD32Sfloat, vk::Format::eD32SfloatS8Uint,
                                              vk::Format::eD24UnormS8Uint};
   mSwapchain.DepthFormat = FindFormat(depthFormats, vk::ImageTiling::eOptimal,
@@ -912,18 +1808,10 @@ void Application::CreateSwapchain() {
   const vk::ImageCreateInfo depthCI(
       {}, vk::ImageType::e2D, mSwapchain.DepthFormat, vk::Extent3D(mSwapchain.Extent, 1), 1, 1,
       vk::SampleCountFlagBits::e1, vk::ImageTiling::eOptimal,
-      vk::ImageUsageFlagBits::eDepthStencilAttachment, sharing, queues);
+      vk::ImageUsageFlagBits::eDepthStencilAttachment, vk::SharingMode::eExclusive);
   mSwapchain.DepthImage = mDevice->createImageUnique(depthCI);
-
-  const vk::MemoryRequirements depthReq{
-      mDevice->getImageMemoryRequirements(*mSwapchain.DepthImage)};
-  const uint32_t memType{
-      FindMemoryType(depthReq.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal)};
-
-  const vk::MemoryAllocateInfo memoryAI(depthReq.size, memType);
-  mSwapchain.DepthMemory = mDevice->allocateMemoryUnique(memoryAI);
-
-  mDevice->bindImageMemory(*mSwapchain.DepthImage, *mSwapchain.DepthMemory, 0);
+  mSwapchain.DepthMemory =
+      mAllocator->AllocateImage(*mSwapchain.DepthImage, vk::MemoryPropertyFlagBits::eDeviceLocal);
 
   const vk::ImageViewCreateInfo depthViewCI(
       {}, *mSwapchain.DepthImage, vk::ImageViewType::e2D, depthCI.format, {},
@@ -936,17 +1824,22 @@ void Application::DestroySwapchain() noexcept {
     iv.reset();
   }
   mSwapchain.DepthImageView.reset();
-  mSwapchain.DepthMemory.reset();
+  mSwapchain.DepthMemory.Free();
   mSwapchain.DepthImage.reset();
+  mSwapchain.OffscreenImages.clear();
+  mSwapchain.OffscreenMemory.clear();
   mSwapchain.Swapchain.reset();
 }
 
 void Application::CreateRenderPass() {
+  RAVEN_PROFILE_SCOPE("CreateRenderPass");
+  // Offscreen targets are never presented, only copied out when a capture is requested.
+  const vk::ImageLayout colorFinalLayout{mHeadless ? vk::ImageLayout::eTransferSrcOptimal
+                                                   : vk::ImageLayout::ePresentSrcKHR};
   const vk::AttachmentDescription colorAttachment(
-      {}, mDeviceInfo.OptimalSwapchainFormat.format, vk::SampleCountFlagBits::e1,
-      vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, vk::AttachmentLoadOp::eDontCare,
-      vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eUndefined,
-      vk::ImageLayout::ePresentSrcKHR);
+      {}, mSwapchain.Format, vk::SampleCountFlagBits::e1, vk::AttachmentLoadOp::eClear,
+      vk::AttachmentStoreOp::eStore, vk::AttachmentLoadOp::eDontCare,
+      vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eUndefined, colorFinalLayout);
   const vk::AttachmentDescription depthAttachment(
       {}, mSwapchain.DepthFormat, vk::SampleCountFlagBits::e1, vk::AttachmentLoadOp::eClear,
       vk::AttachmentStoreOp::eDontCare, vk::AttachmentLoadOp::eDontCare,
@@ -968,6 +1861,7 @@ void Application::CreateRenderPass() {
 }
 
 void Application::CreateFramebuffers() {
+  RAVEN_PROFILE_SCOPE("CreateFramebuffers");
   mSwapchain.Framebuffers.resize(mSwapchain.ImageCount);
   for (uint32_t i = 0; i < mSwapchain.ImageCount; i++) {
     const std::vector<vk::ImageView> attachments{*mSwapchain.ImageViews[i],
@@ -979,160 +1873,596 @@ void Application::CreateFramebuffers() {
 }
 
 void Application::CreateDescriptors() {
-  const std::vector<vk::DescriptorPoolSize> poolSizes{
-      vk::DescriptorPoolSize(vk::DescriptorType::eUniformBuffer, 10)};
-  const vk::DescriptorPoolCreateInfo poolCI({}, 10, poolSizes);
-  mDescriptorPool = mDevice->createDescriptorPoolUnique(poolCI);
-
-  const vk::DescriptorSetLayoutBinding global_CameraBinding(0, vk::DescriptorType::eUniformBuffer,
-                                                            1, vk::ShaderStageFlagBits::eVertex);
-  const std::vector<vk::DescriptorSetLayoutBinding> globalBindings{global_CameraBinding};
-
+  RAVEN_PROFILE_SCOPE("CreateDescriptors");
+  mSceneShaders.AddStage(GetShaderPath("Basic.vert"))
+      .AddStage(GetShaderPath("Basic.frag"))
+      .AddStage(GetShaderPath("Tri.vert"))
+      .AddStage(GetShaderPath("Tri.frag"));
+  mCullShaders.AddStage(GetShaderPath("Cull.comp"));
+
+  const std::vector<vk::DescriptorSetLayoutBinding>& globalBindings{
+      mSceneShaders.GetSetBindings(0)};
   const vk::DescriptorSetLayoutCreateInfo globalSetCI({}, globalBindings);
   mGlobalSetLayout = mDevice->createDescriptorSetLayoutUnique(globalSetCI);
 
+  const std::vector<vk::DescriptorSetLayoutBinding>& cullBindings{mCullShaders.GetSetBindings(0)};
+  const vk::DescriptorSetLayoutCreateInfo cullSetCI({}, cullBindings);
+  mCullSetLayout = mDevice->createDescriptorSetLayoutUnique(cullSetCI);
+
+  // Every frame allocates one global set and one culling set.
+  const uint32_t frameCount{static_cast<uint32_t>(mFrames.size())};
+  std::vector<vk::DescriptorPoolSize> poolSizes;
+  for (const auto* bindings : {&globalBindings, &cullBindings}) {
+    for (const auto& binding : *bindings) {
+      bool found{false};
+      for (auto& poolSize : poolSizes) {
+        if (poolSize.type == binding.descriptorType) {
+          poolSize.descriptorCount += binding.descriptorCount * frameCount;
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        poolSizes.emplace_back(binding.descriptorType, binding.descriptorCount * frameCount);
+      }
+    }
+  }
+  const vk::DescriptorPoolCreateInfo poolCI({}, frameCount * 2, poolSizes);
+  mDescriptorPool = mDevice->createDescriptorPoolUnique(poolCI);
+
   for (auto& frame : mFrames) {
-    frame.Global_CameraBuffer =
-        CreateBuffer(sizeof(GlobalDescriptor_Camera), vk::BufferUsageFlagBits::eUniformBuffer,
-                     vk::MemoryPropertyFlagBits::eHostVisible);
+    frame.Uniforms =
+        UniformAllocator(*mAllocator, gFrameUniformSize,
+                         mDeviceInfo.Properties.limits.minUniformBufferOffsetAlignment);
 
     const vk::DescriptorSetAllocateInfo globalSetAI(mDescriptorPool.get(), mGlobalSetLayout.get());
     auto sets{mDevice->allocateDescriptorSets(globalSetAI)};
     frame.GlobalSet = std::move(sets[0]);
 
-    const vk::DescriptorBufferInfo global_CameraInfo(frame.Global_CameraBuffer.Handle.get(), 0,
-                                                     frame.Global_CameraBuffer.Size);
-    const vk::WriteDescriptorSet global_CameraWrite(
-        frame.GlobalSet, 0u, 0u, vk::DescriptorType::eUniformBuffer, nullptr, global_CameraInfo);
+    // The culling buffers are created along with the scene, and written in UpdateCullScene.
+    const vk::DescriptorSetAllocateInfo cullSetAI(mDescriptorPool.get(), mCullSetLayout.get());
+    frame.CullSet = mDevice->allocateDescriptorSets(cullSetAI)[0];
+
+    const vk::DescriptorBufferInfo global_CameraInfo(frame.Uniforms.GetBuffer().Handle.get(), 0,
+                                                     sizeof(GlobalDescriptor_Camera));
+    const vk::WriteDescriptorSet global_CameraWrite(frame.GlobalSet, 0u, 0u,
+                                                    vk::DescriptorType::eUniformBufferDynamic,
+                                                    nullptr, global_CameraInfo);
     mDevice->updateDescriptorSets(global_CameraWrite, nullptr);
   }
 }
 
 void Application::CreatePipeline() {
-  auto bgVertShader{CreateShaderModule("../Shaders/Basic.vert.spv")};
-  auto bgFragShader{CreateShaderModule("../Shaders/Basic.frag.spv")};
-  auto triVertShader{CreateShaderModule("../Shaders/Tri.vert.spv")};
-  auto triFragShader{CreateShaderModule("../Shaders/Tri.frag.spv")};
+  RAVEN_PROFILE_SCOPE("CreatePipeline");
+  const vk::ShaderModule bgVertShader{mPipelines->GetShader(GetShaderPath("Basic.vert"))};
+  const vk::ShaderModule bgFragShader{mPipelines->GetShader(GetShaderPath("Basic.frag"))};
+  const vk::ShaderModule triVertShader{mPipelines->GetShader(GetShaderPath("Tri.vert"))};
+  const vk::ShaderModule triFragShader{mPipelines->GetShader(GetShaderPath("Tri.frag"))};
 
   PipelineLayoutBuilder pipelineLayout;
-  pipelineLayout.AddSetLayout(mGlobalSetLayout.get());
+  pipelineLayout.AddSetLayout(mGlobalSetLayout.get())
+      .AddPushConstants(mSceneShaders.GetPushConstants());
   std::shared_ptr<vk::UniquePipelineLayout> bgLayout{std::make_shared<vk::UniquePipelineLayout>(
       mDevice->createPipelineLayoutUnique(pipelineLayout))};
 
-  pipelineLayout.AddPushConstant<GlobalPushConstants>(vk::ShaderStageFlagBits::eVertex);
   std::shared_ptr<vk::UniquePipelineLayout> triLayout{std::make_shared<vk::UniquePipelineLayout>(
       mDevice->createPipelineLayoutUnique(pipelineLayout))};
 
-  PipelineBuilder builder(mSwapchain.Extent);
+  PipelineBuilder builder;
   builder.Layout = bgLayout.get()->get();
   builder.RenderPass = *mRenderPass;
-  builder.AddShader(vk::ShaderStageFlagBits::eVertex, *bgVertShader)
-      .AddShader(vk::ShaderStageFlagBits::eFragment, *bgFragShader);
-  std::shared_ptr<vk::UniquePipeline> bgPipeline{std::make_shared<vk::UniquePipeline>(
-      mDevice->createGraphicsPipelineUnique({}, builder).value)};
+  builder.AddShader(vk::ShaderStageFlagBits::eVertex, bgVertShader)
+      .AddShader(vk::ShaderStageFlagBits::eFragment, bgFragShader);
+  std::shared_ptr<vk::UniquePipeline> bgPipeline{mPipelines->Request(builder)};
 
   builder.Layout = triLayout.get()->get();
   builder.ClearShaders()
-      .AddShader(vk::ShaderStageFlagBits::eVertex, *triVertShader)
-      .AddShader(vk::ShaderStageFlagBits::eFragment, *triFragShader)
+      .AddShader(vk::ShaderStageFlagBits::eVertex, triVertShader)
+      .AddShader(vk::ShaderStageFlagBits::eFragment, triFragShader)
       .SetVertexInput<Vertex>()
       .EnableDepthBuffer();
-  std::shared_ptr<vk::UniquePipeline> triPipeline{std::make_shared<vk::UniquePipeline>(
-      mDevice->createGraphicsPipelineUnique({}, builder).value)};
+  std::shared_ptr<vk::UniquePipeline> triPipeline{mPipelines->Request(builder)};
+
+  // Only the triangle shaders take vertex input, so catch Vertex drifting out of sync with them.
+  for (const auto& input : mSceneShaders.GetVertexInputs()) {
+    bool matched{false};
+    for (const auto& attribute : builder.VertexInfo.Attributes) {
+      matched |= attribute.location == input.Location && attribute.format == input.Format;
+    }
+    if (!matched) {
+      Log::Warn("[CreatePipeline] Vertex input {} does not match any vertex attribute.",
+                input.Location);
+    }
+  }
+
+  const vk::ShaderModule cullShader{mPipelines->GetShader(GetShaderPath("Cull.comp"))};
+  const auto& cullPushConstants{mCullShaders.GetPushConstants()};
+  if (cullPushConstants.empty() || cullPushConstants[0].size != sizeof(CullPushConstants)) {
+    throw std::runtime_error("Cull shader push constants do not match CullPushConstants!");
+  }
+  PipelineLayoutBuilder cullLayout;
+  cullLayout.AddSetLayout(*mCullSetLayout).AddPushConstants(cullPushConstants);
+  mCullPipelineLayout = mDevice->createPipelineLayoutUnique(cullLayout);
+  // Registered like the graphics pipelines, so hot reloading Cull.comp rebuilds it too.
+  PipelineBuilder cullBuilder;
+  cullBuilder.Layout = *mCullPipelineLayout;
+  cullBuilder.AddShader(vk::ShaderStageFlagBits::eCompute, cullShader);
+  mCullPipeline = mPipelines->Request(cullBuilder);
 
   CreateMaterial(bgLayout, bgPipeline, "background");
   CreateMaterial(triLayout, triPipeline, "default");
+
+  // Every other material falls back to the default one while its pipeline compiles, so that one
+  // has to be ready before the first frame.
+  mPipelines->Wait(triPipeline);
+  if (!*triPipeline) {
+    throw std::runtime_error("Failed to compile the default pipeline!");
+  }
+  // Culling has no fallback either.
+  mPipelines->Wait(mCullPipeline);
+  if (!*mCullPipeline) {
+    throw std::runtime_error("Failed to compile the culling pipeline!");
+  }
+  mPlaceholderMaterial = GetMaterial("default");
 }
 
 void Application::CreateCommandPools() {
+  RAVEN_PROFILE_SCOPE("CreateCommandPools");
   const vk::CommandPoolCreateInfo graphicsPoolCI(vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
                                                  mDeviceInfo.GraphicsIndex.value());
+  const vk::CommandPoolCreateInfo recordPoolCI(vk::CommandPoolCreateFlagBits::eTransient,
+                                               mDeviceInfo.GraphicsIndex.value());
   for (auto& frame : mFrames) {
     frame.CommandPool = mDevice->createCommandPoolUnique(graphicsPoolCI);
+    for (uint32_t i = 0; i < mRecordThreads; i++) {
+      frame.RecordPools.push_back(mDevice->createCommandPoolUnique(recordPoolCI));
+    }
   }
 }
 
 void Application::CreateCommandBuffers() {
+  RAVEN_PROFILE_SCOPE("CreateCommandBuffers");
   for (auto& frame : mFrames) {
     const vk::CommandBufferAllocateInfo cmdAI(*frame.CommandPool, vk::CommandBufferLevel::ePrimary,
                                               1);
     auto cmdBufs{mDevice->allocateCommandBuffersUnique(cmdAI)};
     frame.MainCommandBuffer = std::move(cmdBufs[0]);
+
+    for (const auto& pool : frame.RecordPools) {
+      const vk::CommandBufferAllocateInfo secondaryAI(*pool, vk::CommandBufferLevel::eSecondary, 1);
+      frame.RecordCommandBuffers.push_back(mDevice->allocateCommandBuffers(secondaryAI)[0]);
+    }
   }
 }
 
 void Application::CreateSyncObjects() {
-  const vk::SemaphoreCreateInfo semaphoreCI;
-  const vk::FenceCreateInfo fenceCI(vk::FenceCreateFlagBits::eSignaled);
-
-  for (auto& frame : mFrames) {
-    frame.RenderSemaphore = mDevice->createSemaphoreUnique(semaphoreCI);
-    frame.PresentSemaphore = mDevice->createSemaphoreUnique(semaphoreCI);
-    frame.RenderFence = mDevice->createFenceUnique(fenceCI);
+  RAVEN_PROFILE_SCOPE("CreateSyncObjects");
+  const vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfo> timelineCI{
+      {}, {vk::SemaphoreType::eTimeline, 0}};
+  mFrameTimeline = mDevice->createSemaphoreUnique(timelineCI.get());
+
+  // Only windowed mode presents, and so only it needs binary semaphores.
+  if (!mHeadless) {
+    const vk::SemaphoreCreateInfo semaphoreCI;
+    for (auto& frame : mFrames) {
+      frame.RenderSemaphore = mDevice->createSemaphoreUnique(semaphoreCI);
+      frame.PresentSemaphore = mDevice->createSemaphoreUnique(semaphoreCI);
+    }
   }
 }
 
 void Application::CreateScene() {
-  const std::vector<Vertex> triVerts{Vertex{glm::vec3(1, 1, 0)}, Vertex{glm::vec3(-1, 1, 0)},
-                                     Vertex{glm::vec3(0, -1, 0)}};
-  auto triangle{std::make_shared<Mesh>(3, CreateVertexBuffer(triVerts))};
-  mMeshes["triangle"] = triangle;
+  RAVEN_PROFILE_SCOPE("CreateScene");
+  const MeshData triData{{Vertex{glm::vec3(1, 1, 0)}, Vertex{glm::vec3(-1, 1, 0)},
+                          Vertex{glm::vec3(0, -1, 0)}},
+                         {0, 1, 2}};
+  AddMesh(CreateMesh(triData), "triangle");
+
+  AddMesh(LoadMeshAsync("../Assets/Models/Suzanne.gltf"), "suzanne");
 
-  mMeshes["suzanne"] = LoadMesh("../Assets/Models/Suzanne.gltf");
+  if (mBenchmarkInstances > 0) {
+    CreateBenchmarkScene();
+    return;
+  }
 
-  RenderObject suzanne{GetMesh("suzanne"), GetMaterial("default"),
-                       glm::rotate(glm::mat4(1.0f), glm::radians(180.0f), glm::vec3(0, 1, 0))};
-  mRenderables.push_back(suzanne);
+  mScene.CreateObject(GetMesh("suzanne"), GetMaterial("default"),
+                      glm::rotate(glm::mat4(1.0f), glm::radians(180.0f), glm::vec3(0, 1, 0)));
 
-  std::shared_ptr<Mesh> tri{GetMesh("triangle")};
-  std::shared_ptr<Material> triMat{GetMaterial("default")};
+  const MeshHandle tri{GetMesh("triangle")};
+  const MaterialHandle triMat{GetMaterial("default")};
   for (int x = -20; x <= 20; x++) {
     for (int z = -20; z <= 20; z++) {
       const glm::mat4 scale{glm::scale(glm::mat4(1.0f), glm::vec3(0.2f, 0.2f, 0.2f))};
       const glm::mat4 translate{glm::translate(glm::mat4(1.0f), glm::vec3(x, 0, z))};
       const glm::mat4 xf{translate * scale};
-      RenderObject obj{tri, triMat, xf};
-      mRenderables.push_back(obj);
+      mScene.CreateObject(tri, triMat, xf);
     }
   }
 }
 
+void Application::CreateBenchmarkScene() {
+  RAVEN_PROFILE_SCOPE("CreateBenchmarkScene");
+  // A square grid centered on the origin. Every instance is placed from its index alone, so the
+  // scene is identical from run to run.
+  const MeshHandle tri{GetMesh("triangle")};
+  const MeshHandle suzanne{GetMesh("suzanne")};
+  const MaterialHandle material{GetMaterial("default")};
+  const uint32_t side{static_cast<uint32_t>(std::ceil(std::sqrt(mBenchmarkInstances)))};
+  const float offset{(side - 1) / 2.0f};
+  for (uint32_t i = 0; i < mBenchmarkInstances; i++) {
+    const glm::vec3 position(i % side - offset, 0.0f, i / side - offset);
+    const glm::mat4 rotation{
+        glm::rotate(glm::mat4(1.0f), glm::radians((i * 37) % 360 * 1.0f), glm::vec3(0, 1, 0))};
+    // One instance in sixteen is a full model, the rest are single triangles.
+    if (i % 16 == 0) {
+      const glm::mat4 scale{glm::scale(glm::mat4(1.0f), glm::vec3(0.3f))};
+      mScene.CreateObject(suzanne, material,
+                          glm::translate(glm::mat4(1.0f), position) * rotation * scale);
+    } else {
+      const glm::mat4 scale{glm::scale(glm::mat4(1.0f), glm::vec3(0.2f))};
+      mScene.CreateObject(tri, material,
+                          glm::translate(glm::mat4(1.0f), position) * rotation * scale);
+    }
+  }
+
+  // Start measuring with every mesh loaded and pipeline compiled. Loaded meshes are uploaded by
+  // the first frame.
+  mJobs->WaitIdle();
+  mPipelines->WaitIdle();
+  Log::Info("[CreateBenchmarkScene] Created {} instances in a {}x{} grid.", mBenchmarkInstances,
+            side, side);
+}
+
+void Application::WriteBenchmarkReport() const {
+  const auto timeStats{[](const FrameTimeStats& stats) {
+    return nlohmann::json{{"samples", stats.Samples}, {"avgMs", stats.AvgMs},
+                          {"p50Ms", stats.P50Ms},     {"p95Ms", stats.P95Ms},
+                          {"p99Ms", stats.P99Ms},     {"maxMs", stats.MaxMs}};
+  }};
+
+  nlohmann::json report;
+  report["device"] = fmt::format("{}", mDeviceInfo.Properties.deviceName);
+  report["driverVersion"] = mDeviceInfo.Properties.driverVersion;
+  report["instances"] = mBenchmarkInstances;
+  report["warmupFrames"] = gBenchmarkWarmupFrames;
+  report["extent"] = {mSwapchain.Extent.width, mSwapchain.Extent.height};
+  report["headless"] = mHeadless;
+  report["gpuCulling"] = mGpuCulling;
+  report["framesInFlight"] = mFramesInFlight;
+  report["recordThreads"] = mRecordThreads;
+
+  const FrameStatsSummary stats{mFrameStats.GetRunStats()};
+  report["frames"] = stats.Frames;
+  report["budgetMs"] = mFrameStats.Budget();
+  report["hitches"] = stats.Hitches;
+  report["cpu"] = timeStats(stats.Cpu);
+  report["gpu"] = timeStats(stats.Gpu);
+  report["wait"] = timeStats(stats.Wait);
+
+  auto passes{nlohmann::json::array()};
+  for (const auto& pass : mGpuProfiler->GetStats()) {
+    passes.push_back({{"name", pass.Name},
+                      {"samples", pass.Samples},
+                      {"minMs", pass.MinMs},
+                      {"avgMs", pass.AvgMs},
+                      {"p99Ms", pass.P99Ms},
+                      {"maxMs", pass.MaxMs}});
+  }
+  report["gpuPasses"] = passes;
+
+  const AllocatorStats memory{mAllocator->GetStats()};
+  report["memory"] = {{"allocations", memory.AllocationCount},
+                      {"blocks", memory.BlockCount},
+                      {"dedicatedBlocks", memory.DedicatedBlockCount},
+                      {"reservedBytes", memory.ReservedBytes},
+                      {"usedBytes", memory.UsedBytes},
+                      {"freeBytes", memory.FreeBytes},
+                      {"largestFreeRange", memory.LargestFreeRange},
+                      {"fragmentation", memory.Fragmentation()}};
+
+  std::ofstream file(mBenchmarkReportPath, std::ios::out | std::ios::trunc);
+  file << report.dump(2) << std::endl;
+  if (!file) {
+    Log::Error("[WriteBenchmarkReport] Failed to write benchmark report to {}.",
+               mBenchmarkReportPath);
+    return;
+  }
+  Log::Info("[WriteBenchmarkReport] Benchmark report written to {}.", mBenchmarkReportPath);
+}
+
 /* ==========================================================================================
  * Application Helper Methods
  * ========================================================================================== */
 
 Buffer Application::CreateBuffer(const vk::DeviceSize size, vk::BufferUsageFlags usage,
                                  vk::MemoryPropertyFlags memoryType) {
-  const vk::BufferCreateInfo bufferCI({}, size, usage);
-  vk::UniqueBuffer buffer{mDevice->createBufferUnique(bufferCI)};
+  return mAllocator->CreateBuffer(size, usage, memoryType);
+}
 
-  const vk::MemoryRequirements require{mDevice->getBufferMemoryRequirements(*buffer)};
-  const uint32_t memType{FindMemoryType(
-      require.memoryTypeBits,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)};
+Buffer Application::CreateVertexBuffer(const void* vertices, vk::DeviceSize size) {
+  Buffer buf{CreateBuffer(
+      size, vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
+      vk::MemoryPropertyFlagBits::eDeviceLocal)};
+  mTransfer->Upload(buf, vertices, size);
 
-  const vk::MemoryAllocateInfo memoryAI(require.size, memType);
-  vk::UniqueDeviceMemory memory{mDevice->allocateMemoryUnique(memoryAI)};
+  return buf;
+}
 
-  mDevice->bindBufferMemory(*buffer, *memory, 0);
+Buffer Application::CreateIndexBuffer(const void* indices, vk::DeviceSize size) {
+  Buffer buf{CreateBuffer(
+      size, vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst,
+      vk::MemoryPropertyFlagBits::eDeviceLocal)};
+  mTransfer->Upload(buf, indices, size);
 
-  return Buffer(std::move(buffer), std::move(memory), require.size);
+  return buf;
 }
 
-Buffer Application::CreateVertexBuffer(const std::vector<Vertex>& vertices) {
-  const vk::DeviceSize bufSize{vertices.size() * sizeof(Vertex)};
-  Buffer buf{CreateBuffer(
-      bufSize, vk::BufferUsageFlagBits::eVertexBuffer,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)};
+std::shared_ptr<Mesh> Application::LoadMesh(const std::string& path,
+                                            const MeshImportOptions& options) {
+  RAVEN_PROFILE_SCOPE("LoadMesh");
+  CookedMesh cooked;
+  if (!CookMesh(path, options, cooked)) {
+    return nullptr;
+  }
+
+  return CreateMesh(cooked);
+}
 
-  void* data{mDevice->mapMemory(*buf.Memory, 0, bufSize)};
-  memcpy(data, vertices.data(), bufSize);
-  mDevice->unmapMemory(*buf.Memory);
+std::shared_ptr<Mesh> Application::LoadMeshAsync(const std::string& path,
+                                                 const MeshImportOptions& options) {
+  auto mesh{std::make_shared<Mesh>()};
+  mJobs->Submit([this, path, options, mesh]() {
+    auto cooked{std::make_unique<CookedMesh>()};
+    if (!CookMesh(path, options, *cooked)) {
+      cooked.reset();
+    }
+
+    std::lock_guard<std::mutex> lock(mPendingMeshMutex);
+    mPendingMeshes.push_back({mesh, std::move(cooked), path});
+  });
+
+  return mesh;
+}
+
+void Application::ProcessPendingMeshes() {
+  RAVEN_PROFILE_SCOPE("ProcessPendingMeshes");
+  std::vector<PendingMesh> pending;
+  {
+    std::lock_guard<std::mutex> lock(mPendingMeshMutex);
+    pending.swap(mPendingMeshes);
+  }
+
+  // Uploads are queued on the transfer manager here and submitted with the next frame, which also
+  // waits for them on the GPU, so the mesh can be drawn immediately.
+  for (auto& mesh : pending) {
+    if (!mesh.Cooked) {
+      Log::Error("[ProcessPendingMeshes] Failed to load {}", mesh.Path);
+      continue;
+    }
+    *mesh.Target = std::move(*CreateMesh(*mesh.Cooked));
+    mCullSceneDirty = true;
+  }
+}
+
+void Application::ProcessShaderChanges() {
+  RAVEN_PROFILE_SCOPE("ProcessShaderChanges");
+  if (!mShaderWatcher) {
+    return;
+  }
 
-  return std::move(buf);
+  const auto compile{[this](const std::string& file) {
+    Log::Info("[ProcessShaderChanges] {} changed, recompiling.", file);
+    mCompilingShaders.insert(file);
+    mJobs->Submit([this, file]() {
+      const bool success{CompileShader(file)};
+      std::lock_guard<std::mutex> lock(mCompiledShaderMutex);
+      mCompiledShaders.emplace_back(file, success);
+    });
+  }};
+
+  for (const auto& file : mShaderWatcher->Poll()) {
+    const size_t extension{file.rfind('.')};
+    const std::string stage{extension == std::string::npos ? "" : file.substr(extension)};
+    if (stage != ".vert" && stage != ".frag" && stage != ".comp") {
+      continue;
+    }
+
+    // Saves in quick succession coalesce into one more compile once the current one finishes.
+    if (mCompilingShaders.count(file) > 0) {
+      mRecompileShaders.insert(file);
+    } else {
+      compile(file);
+    }
+  }
+
+  std::vector<std::pair<std::string, bool>> compiled;
+  {
+    std::lock_guard<std::mutex> lock(mCompiledShaderMutex);
+    compiled.swap(mCompiledShaders);
+  }
+
+  // Descriptor set and pipeline layouts are built once at startup, so edits must keep the same
+  // resource interface.
+  for (const auto& [file, success] : compiled) {
+    mCompilingShaders.erase(file);
+    // A newer edit supersedes this result.
+    if (mRecompileShaders.erase(file) > 0) {
+      compile(file);
+      continue;
+    }
+    if (!success) {
+      continue;
+    }
+
+    const uint32_t rebuilt{mPipelines->ReloadShader(GetShaderPath(file))};
+    Log::Info("[ProcessShaderChanges] Reloaded {}, rebuilding {} pipelines.", file, rebuilt);
+  }
 }
 
-std::shared_ptr<Mesh> Application::LoadMesh(const std::string& path) {
+bool Application::CompileShader(const std::string& name) {
+  RAVEN_PROFILE_SCOPE("CompileShader");
+#ifdef RAVEN_SHADER_SOURCE_DIR
+  const std::string source{fmt::format("{}/{}", RAVEN_SHADER_SOURCE_DIR, name)};
+  const std::string output{GetShaderPath(name)};
+  // Compile beside the output and rename over it, so the module is never read half written.
+  const std::string tempPath{output + ".tmp"};
+
+  const auto runCommand{[](std::string command) {
+#ifdef _WIN32
+    // cmd.exe strips the first and last quote of the command line when there are more than two.
+    command = "\"" + command + "\"";
+#endif
+    return std::system(command.c_str()) == 0;
+  }};
+
+  if (!runCommand(fmt::format("\"{}\" -V \"{}\" -o \"{}\"", RAVEN_GLSLANG_VALIDATOR, source,
+                              tempPath))) {
+    Log::Error("[CompileShader] Failed to compile {}", name);
+    std::remove(tempPath.c_str());
+    return false;
+  }
+#ifdef RAVEN_SPIRV_OPT
+  const std::string optimizedPath{output + ".opt.tmp"};
+  if (!runCommand(fmt::format("\"{}\" -O \"{}\" -o \"{}\"", RAVEN_SPIRV_OPT, tempPath,
+                              optimizedPath))) {
+    Log::Error("[CompileShader] Failed to optimize {}", name);
+    std::remove(tempPath.c_str());
+    std::remove(optimizedPath.c_str());
+    return false;
+  }
+  std::remove(tempPath.c_str());
+  std::rename(optimizedPath.c_str(), tempPath.c_str());
+#endif
+
+  std::remove(output.c_str());
+  if (std::rename(tempPath.c_str(), output.c_str()) != 0) {
+    Log::Error("[CompileShader] Failed to replace {}", output);
+    std::remove(tempPath.c_str());
+    return false;
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool Application::CookMesh(const std::string& path, const MeshImportOptions& options,
+                           CookedMesh& cooked) {
+  RAVEN_PROFILE_SCOPE("CookMesh");
+  const auto startTime{std::chrono::high_resolution_clock::now()};
+  const auto elapsedMs{[startTime]() {
+    return std::chrono::duration<float, std::chrono::milliseconds::period>(
+               std::chrono::high_resolution_clock::now() - startTime)
+        .count();
+  }};
+
+  // The cache key covers the glTF itself, its binary buffer, everything that changes how it is
+  // processed, and the vertex layout.
+  const std::string binPath{path.substr(0, path.find_last_of('.')) + ".bin"};
+  uint64_t sourceHash{HashFile(binPath, HashFile(path))};
+  const uint32_t vertexStride{sizeof(Vertex)};
+  sourceHash = HashData(&vertexStride, sizeof(vertexStride), sourceHash);
+  sourceHash = HashData(&options.WeldVertices, sizeof(options.WeldVertices), sourceHash);
+  sourceHash =
+      HashData(&options.OptimizeVertexCache, sizeof(options.OptimizeVertexCache), sourceHash);
+  sourceHash = HashData(&options.OptimizeOverdraw, sizeof(options.OptimizeOverdraw), sourceHash);
+  sourceHash =
+      HashData(&options.OptimizeVertexFetch, sizeof(options.OptimizeVertexFetch), sourceHash);
+  sourceHash = HashData(&options.OverdrawThreshold, sizeof(options.OverdrawThreshold), sourceHash);
+
+  // On a hit, the streams are later copied straight from the mapping into the staging ring.
+  const std::string cachePath{path + ".rvmesh"};
+  MappedFile file(cachePath);
+  MeshCacheView view;
+  if (ReadMeshCache(file, sourceHash, vertexStride, view)) {
+    cooked.Header = *view.Header;
+    cooked.VertexData = view.Vertices;
+    cooked.IndexData = view.Indices;
+    cooked.File = std::move(file);
+    Log::Debug("[CookMesh] Loaded {} from cache in {:.2f}ms", path, elapsedMs());
+
+    return true;
+  }
+
+  MeshData data;
+  if (!ParseMesh(path, data)) {
+    return false;
+  }
+  if (data.Vertices.empty()) {
+    Log::Error("[CookMesh] {} contains no triangle geometry.", path);
+    return false;
+  }
+
+  const size_t importedVertices{data.Vertices.size()};
+  if (options.WeldVertices) {
+    WeldVertices(data.Vertices, data.Indices);
+  }
+
+  Log::Debug("[CookMesh] Loaded {}: {} vertices ({} before welding), {} indices", path,
+             data.Vertices.size(), importedVertices, data.Indices.size());
+
+  OptimizeMesh(data, options);
+
+  MeshCacheHeader& header{cooked.Header};
+  header.SourceHash = sourceHash;
+  header.VertexCount = static_cast<uint32_t>(data.Vertices.size());
+  header.VertexStride = vertexStride;
+  header.IndexCount = static_cast<uint32_t>(data.Indices.size());
+  header.IndexSize = GetIndexSize(data.Vertices.size());
+  header.Bounds = ComputeBounds(&data.Vertices[0].Position.x, sizeof(Vertex), data.Vertices.size());
+
+  cooked.Indices.resize(data.Indices.size() * header.IndexSize);
+  PackIndices(cooked.Indices.data(), data.Indices.data(), data.Indices.size(), header.IndexSize);
+  cooked.Vertices = std::move(data.Vertices);
+  cooked.VertexData = cooked.Vertices.data();
+  cooked.IndexData = cooked.Indices.data();
+
+  if (!WriteMeshCache(cachePath, header, cooked.VertexData, cooked.IndexData)) {
+    Log::Warn("[CookMesh] Failed to write mesh cache {}", cachePath);
+  }
+
+  Log::Debug("[CookMesh] Cooked {} in {:.2f}ms", path, elapsedMs());
+
+  return true;
+}
+
+void Application::OptimizeMesh(MeshData& data, const MeshImportOptions& options) {
+  RAVEN_PROFILE_SCOPE("OptimizeMesh");
+  if (data.Indices.empty()) {
+    return;
+  }
+
+  const VertexCacheStats before{
+      AnalyzeVertexCache(data.Indices.data(), data.Indices.size(), data.Vertices.size())};
+
+  if (options.OptimizeVertexCache) {
+    std::vector<uint32_t> optimized(data.Indices.size());
+    Raven::OptimizeVertexCache(optimized.data(), data.Indices.data(), data.Indices.size(),
+                               data.Vertices.size());
+    data.Indices = std::move(optimized);
+  }
+
+  if (options.OptimizeOverdraw) {
+    std::vector<uint32_t> optimized(data.Indices.size());
+    Raven::OptimizeOverdraw(optimized.data(), data.Indices.data(), data.Indices.size(),
+                            &data.Vertices[0].Position.x, sizeof(Vertex), data.Vertices.size(),
+                            options.OverdrawThreshold);
+    data.Indices = std::move(optimized);
+  }
+
+  if (options.OptimizeVertexFetch) {
+    Raven::OptimizeVertexFetch(data.Vertices, data.Indices);
+  }
+
+  const VertexCacheStats after{
+      AnalyzeVertexCache(data.Indices.data(), data.Indices.size(), data.Vertices.size())};
+  Log::Debug("[OptimizeMesh] ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}", before.ACMR,
+             after.ACMR, before.ATVR, after.ATVR);
+}
+
+bool Application::ParseMesh(const std::string& path, MeshData& data) {
+  RAVEN_PROFILE_SCOPE("ParseMesh");
   tinygltf::Model model;
   tinygltf::TinyGLTF loader;
   std::string err;
@@ -1141,55 +2471,121 @@ std::shared_ptr<Mesh> Application::LoadMesh(const std::string& path) {
   bool ret = loader.LoadASCIIFromFile(&model, &err, &warn, path.c_str());
 
   if (!warn.empty()) {
-    Log::Warn("Warn: %s\n", warn.c_str());
+    Log::Warn("[ParseMesh] {}", warn);
   }
 
   if (!err.empty()) {
-    Log::Error("Err: %s\n", err.c_str());
+    Log::Error("[ParseMesh] {}", err);
   }
 
   if (!ret) {
     Log::Error("Failed to parse glTF model {}", path);
-    return nullptr;
+    return false;
   }
 
-  std::vector<Vertex> vertices;
+  // Returns a pointer to the first element of an accessor, along with the stride between elements.
+  const auto accessorData{[&model](const tinygltf::Accessor& accessor, size_t elementSize) {
+    const tinygltf::BufferView& view{model.bufferViews[accessor.bufferView]};
+    const tinygltf::Buffer& buffer{model.buffers[view.buffer]};
+    const uint8_t* ptr{&buffer.data[view.byteOffset + accessor.byteOffset]};
+    const size_t stride{view.byteStride == 0 ? elementSize : view.byteStride};
+
+    return std::make_pair(ptr, stride);
+  }};
+
+  data.Vertices.clear();
+  data.Indices.clear();
   for (const auto& m : model.meshes) {
     for (const auto& p : m.primitives) {
-      const tinygltf::Accessor& pos{model.accessors[p.attributes.find("POSITION")->second]};
-      const tinygltf::BufferView& posBufView{model.bufferViews[pos.bufferView]};
-      const tinygltf::Buffer& posBuf = model.buffers[posBufView.buffer];
-      const float* positions =
-          reinterpret_cast<const float*>(&posBuf.data[posBufView.byteOffset + pos.byteOffset]);
-
-      const tinygltf::Accessor& norm{model.accessors[p.attributes.find("NORMAL")->second]};
-      const tinygltf::BufferView& normalBufView{model.bufferViews[norm.bufferView]};
-      const tinygltf::Buffer& normalBuf = model.buffers[normalBufView.buffer];
-      const float* normals = reinterpret_cast<const float*>(
-          &normalBuf.data[normalBufView.byteOffset + norm.byteOffset]);
+      if (p.mode != TINYGLTF_MODE_TRIANGLES) {
+        Log::Warn("[ParseMesh] Skipping non-triangle primitive in {}", path);
+        continue;
+      }
+
+      const auto posIt{p.attributes.find("POSITION")};
+      if (posIt == p.attributes.end()) {
+        continue;
+      }
+      const tinygltf::Accessor& pos{model.accessors[posIt->second]};
+      const auto [positions, posStride]{accessorData(pos, sizeof(glm::vec3))};
 
+      const auto normIt{p.attributes.find("NORMAL")};
+      std::pair<const uint8_t*, size_t> normals{nullptr, 0};
+      if (normIt != p.attributes.end()) {
+        normals = accessorData(model.accessors[normIt->second], sizeof(glm::vec3));
+      }
+
+      const uint32_t baseVertex{static_cast<uint32_t>(data.Vertices.size())};
+      data.Vertices.reserve(data.Vertices.size() + pos.count);
       for (size_t i = 0; i < pos.count; i++) {
-        vertices.push_back(
-            Vertex{glm::vec3{positions[i * 3 + 0], positions[i * 3 + 1], positions[i * 3 + 2]},
-                   glm::vec3{normals[i * 3 + 0], normals[i * 3 + 1], normals[i * 3 + 2]}});
+        Vertex vertex{};
+        memcpy(&vertex.Position, positions + i * posStride, sizeof(glm::vec3));
+        if (normals.first) {
+          memcpy(&vertex.Normal, normals.first + i * normals.second, sizeof(glm::vec3));
+        }
+        data.Vertices.push_back(vertex);
+      }
+
+      if (p.indices < 0) {
+        for (uint32_t i = 0; i < pos.count; i++) {
+          data.Indices.push_back(baseVertex + i);
+        }
+        continue;
+      }
+
+      const tinygltf::Accessor& idx{model.accessors[p.indices]};
+      const size_t indexSize{static_cast<size_t>(
+          tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(idx.componentType)))};
+      const auto [indices, idxStride]{accessorData(idx, indexSize)};
+      data.Indices.reserve(data.Indices.size() + idx.count);
+      for (size_t i = 0; i < idx.count; i++) {
+        const uint8_t* index{indices + i * idxStride};
+        uint32_t value{0};
+        switch (idx.componentType) {
+          case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            value = *index;
+            break;
+          case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+            value = *reinterpret_cast<const uint16_t*>(index);
+            break;
+          case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+            value = *reinterpret_cast<const uint32_t*>(index);
+            break;
+        }
+        data.Indices.push_back(baseVertex + value);
       }
     }
   }
 
-  Buffer buffer{CreateVertexBuffer(vertices)};
+  return true;
+}
+
+std::shared_ptr<Mesh> Application::CreateMesh(const MeshData& data) {
+  const uint32_t indexSize{GetIndexSize(data.Vertices.size())};
+  std::vector<uint8_t> indices(data.Indices.size() * indexSize);
+  PackIndices(indices.data(), data.Indices.data(), data.Indices.size(), indexSize);
 
-  return std::make_shared<Mesh>(static_cast<uint32_t>(vertices.size()), std::move(buffer));
+  return CreateMesh(
+      data.Vertices.data(), static_cast<uint32_t>(data.Vertices.size()), indices.data(),
+      static_cast<uint32_t>(data.Indices.size()), indexSize,
+      ComputeBounds(&data.Vertices[0].Position.x, sizeof(Vertex), data.Vertices.size()));
 }
 
-uint32_t Application::FindMemoryType(uint32_t filter, vk::MemoryPropertyFlags properties) {
-  for (uint32_t i = 0; i < mDeviceInfo.MemoryProperties.memoryTypeCount; i++) {
-    if ((filter & (1 << i)) &&
-        (mDeviceInfo.MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-      return i;
-    }
-  }
+std::shared_ptr<Mesh> Application::CreateMesh(const CookedMesh& cooked) {
+  return CreateMesh(cooked.VertexData, cooked.Header.VertexCount, cooked.IndexData,
+                    cooked.Header.IndexCount, cooked.Header.IndexSize, cooked.Header.Bounds);
+}
+
+std::shared_ptr<Mesh> Application::CreateMesh(const void* vertices, uint32_t vertexCount,
+                                              const void* indices, uint32_t indexCount,
+                                              uint32_t indexSize, const BoundingBox& bounds) {
+  Buffer vertexBuffer{CreateVertexBuffer(vertices, vertexCount * sizeof(Vertex))};
+  Buffer indexBuffer{CreateIndexBuffer(indices, indexCount * indexSize)};
+  const vk::IndexType indexType{indexSize == sizeof(uint16_t) ? vk::IndexType::eUint16
+                                                              : vk::IndexType::eUint32};
 
-  throw std::runtime_error("No memory type is available that meets requirements!");
+  return std::make_shared<Mesh>(vertexCount, std::move(vertexBuffer), indexCount,
+                                std::move(indexBuffer), indexType, bounds);
 }
 
 vk::Format Application::FindFormat(const std::vector<vk::Format>& candidates,
@@ -1208,73 +2604,53 @@ vk::Format Application::FindFormat(const std::vector<vk::Format>& candidates,
       "No format could be found that supports the required features!");
 }
 
-vk::UniqueShaderModule Application::CreateShaderModule(const std::string& path) {
-  std::ifstream file(path, std::ios::ate | std::ios::binary);
-  const size_t fileSize{static_cast<size_t>(file.tellg())};
-  std::vector<char> buffer(fileSize);
-  file.seekg(0);
-  file.read(buffer.data(), fileSize);
-  file.close();
-
-  const vk::ShaderModuleCreateInfo shaderModuleCI({}, fileSize,
-                                                  reinterpret_cast<uint32_t*>(buffer.data()));
-  return mDevice->createShaderModuleUnique(shaderModuleCI);
-}
-
-std::shared_ptr<Material> Application::CreateMaterial(
-    const std::shared_ptr<vk::UniquePipelineLayout> layout,
-    const std::shared_ptr<vk::UniquePipeline> pipeline, const std::string& name) {
+MaterialHandle Application::CreateMaterial(const std::shared_ptr<vk::UniquePipelineLayout> layout,
+                                          const std::shared_ptr<vk::UniquePipeline> pipeline,
+                                          const std::string& name) {
   auto existing{mMaterials.find(name)};
   if (existing != mMaterials.end()) {
     return existing->second;
   }
 
-  std::shared_ptr<Material> newMat{std::make_shared<Material>(layout, pipeline)};
-  mMaterials[name] = newMat;
+  const MaterialHandle handle{mScene.AddMaterial(std::make_shared<Material>(layout, pipeline))};
+  mMaterials[name] = handle;
 
-  return newMat;
+  return handle;
 }
 
-std::shared_ptr<Material> Application::GetMaterial(const std::string& name) {
+MaterialHandle Application::GetMaterial(const std::string& name) {
   auto existing{mMaterials.find(name)};
   if (existing != mMaterials.end()) {
     return existing->second;
   }
 
-  return nullptr;
+  return InvalidHandle;
 }
 
-std::shared_ptr<Mesh> Application::GetMesh(const std::string& name) {
+MeshHandle Application::AddMesh(std::shared_ptr<Mesh> mesh, const std::string& name) {
   auto existing{mMeshes.find(name)};
   if (existing != mMeshes.end()) {
     return existing->second;
   }
 
-  return nullptr;
-}
-
-/* ==========================================================================================
- * Helper Class Methods
- * ========================================================================================== */
-
-Buffer::Buffer(vk::UniqueBuffer buffer, vk::UniqueDeviceMemory memory, vk::DeviceSize size)
-    : Handle(std::move(buffer)), Memory(std::move(memory)), Size(size) {}
+  const MeshHandle handle{mScene.AddMesh(std::move(mesh))};
+  mMeshes[name] = handle;
 
-Buffer::Buffer(Buffer&& o) {
-  Handle = std::move(o.Handle);
-  Memory = std::move(o.Memory);
-  Size = o.Size;
+  return handle;
 }
 
-Buffer& Buffer::operator=(Buffer&& o) {
-  Handle = std::move(o.Handle);
-  Memory = std::move(o.Memory);
-  Size = o.Size;
+MeshHandle Application::GetMesh(const std::string& name) {
+  auto existing{mMeshes.find(name)};
+  if (existing != mMeshes.end()) {
+    return existing->second;
+  }
 
-  return *this;
+  return InvalidHandle;
 }
 
-Buffer::~Buffer() {}
+/* ==========================================================================================
+ * Helper Class Methods
+ * ========================================================================================== */
 
 VertexDescription Vertex::GetVertexDescription() {
   const std::vector<vk::VertexInputBindingDescription> bindings{
@@ -1289,7 +2665,15 @@ VertexDescription Vertex::GetVertexDescription() {
   return VertexDescription{attributes, bindings};
 }
 
-Mesh::Mesh(uint32_t count, Buffer&& buffer) : VertexCount(count), VertexBuffer(std::move(buffer)) {}
+Mesh::Mesh(uint32_t vertexCount, Buffer&& vertexBuffer, uint32_t indexCount, Buffer&& indexBuffer,
+           vk::IndexType indexType, const BoundingBox& bounds)
+    : VertexCount(vertexCount),
+      VertexBuffer(std::move(vertexBuffer)),
+      IndexCount(indexCount),
+      IndexBuffer(std::move(indexBuffer)),
+      IndexType(indexType),
+      Bounds(bounds),
+      Ready(true) {}
 
 Material::Material(std::shared_ptr<vk::UniquePipelineLayout> layout,
                    std::shared_ptr<vk::UniquePipeline> pipeline)
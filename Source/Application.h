@@ -1,32 +1,51 @@
 #pragma once
 
+#include <deque>
 #include <glm/glm.hpp>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
+#include "DeviceAllocator.h"
+#include "FrameStats.h"
+#include "Frustum.h"
+#include "GpuProfiler.h"
+#include "MeshCache.h"
+#include "MeshProcessing.h"
+#include "PipelineCache.h"
+#include "PipelineRegistry.h"
+#include "RenderQueue.h"
+#include "Scene.h"
+#include "ShaderReflection.h"
+#include "UniformAllocator.h"
 #include "VulkanCore.h"
 
 namespace Raven {
+class FileWatcher;
+class JobSystem;
+class TransferManager;
 class Window;
 
-class Buffer {
- public:
-  Buffer() {}
-  Buffer(vk::UniqueBuffer buffer, vk::UniqueDeviceMemory memory, vk::DeviceSize size);
-  Buffer(const Buffer&) = delete;
-  Buffer(Buffer&& o);
-  Buffer& operator=(Buffer&& o);
-  ~Buffer();
+// Per-object data, indexed by ObjectHandle. Matches Object in Tri.vert and Cull.comp.
+struct ObjectData final {
+  glm::mat4 Model;
+};
 
-  vk::UniqueBuffer Handle;
-  vk::UniqueDeviceMemory Memory;
-  vk::DeviceSize Size;
+// Per-object data read by the GPU culling pass. Matches CullObject in Cull.comp.
+struct CullObject final {
+  glm::vec4 BoundsMin;
+  glm::vec3 BoundsMax;
+  uint32_t Batch;
+  uint32_t Object;
+  uint32_t Padding[3];
 };
 
-struct GlobalPushConstants final {
-  glm::mat4 Model;
+struct CullPushConstants final {
+  glm::vec4 Planes[6];
+  uint32_t ObjectCount;
 };
 
 struct GlobalDescriptor_Camera {
@@ -35,11 +54,6 @@ struct GlobalDescriptor_Camera {
   glm::mat4 ViewProjection;
 };
 
-struct VertexDescription final {
-  std::vector<vk::VertexInputAttributeDescription> Attributes;
-  std::vector<vk::VertexInputBindingDescription> Bindings;
-};
-
 struct Vertex {
   glm::vec3 Position;
   glm::vec3 Normal;
@@ -47,37 +61,78 @@ struct Vertex {
   static VertexDescription GetVertexDescription();
 };
 
+struct MeshData final {
+  std::vector<Vertex> Vertices;
+  std::vector<uint32_t> Indices;
+};
+
+struct MeshImportOptions final {
+  bool WeldVertices{true};
+  bool OptimizeVertexCache{true};
+  bool OptimizeOverdraw{true};
+  bool OptimizeVertexFetch{true};
+  // Maximum ACMR degradation the overdraw pass may trade for better draw order.
+  float OverdrawThreshold{1.05f};
+};
+
+// A mesh ready to be uploaded, either mapped from the mesh cache or freshly cooked from glTF.
+struct CookedMesh final {
+  MeshCacheHeader Header;
+  MappedFile File;
+  std::vector<Vertex> Vertices;
+  std::vector<uint8_t> Indices;
+  const void* VertexData{nullptr};
+  const void* IndexData{nullptr};
+};
+
 struct Mesh {
-  Mesh(uint32_t count, Buffer&& buffer);
+  // Placeholder for a mesh that is still loading.
+  Mesh() = default;
+  Mesh(uint32_t vertexCount, Buffer&& vertexBuffer, uint32_t indexCount, Buffer&& indexBuffer,
+       vk::IndexType indexType, const BoundingBox& bounds);
 
-  uint32_t VertexCount;
+  uint32_t VertexCount{0};
   Buffer VertexBuffer;
+  uint32_t IndexCount{0};
+  Buffer IndexBuffer;
+  vk::IndexType IndexType{vk::IndexType::eUint16};
+  BoundingBox Bounds;
+  bool Ready{false};
 };
 
 struct Material {
   Material(std::shared_ptr<vk::UniquePipelineLayout> layout,
            std::shared_ptr<vk::UniquePipeline> pipeline);
 
+  // Pipelines are compiled in the background, and stay null until published.
+  bool Ready() const noexcept { return Pipeline && *Pipeline; }
+
   std::shared_ptr<vk::UniquePipeline> Pipeline;
   std::shared_ptr<vk::UniquePipelineLayout> Layout;
 };
 
-struct RenderObject {
-  std::shared_ptr<Mesh> Mesh;
-  std::shared_ptr<Material> Material;
-  glm::mat4 Transform;
+// A run of scene objects sharing a mesh and material, drawn with a single instanced draw.
+struct RenderBatch {
+  Raven::Mesh* Mesh{nullptr};
+  Raven::Material* Material{nullptr};
+  uint32_t FirstInstance{0};
+  uint32_t InstanceCount{0};
 };
 
 struct VulkanSwapchain final {
   vk::UniqueSwapchainKHR Swapchain;
   uint32_t ImageCount{0};
   vk::Extent2D Extent{0, 0};
+  vk::Format Format;
   std::vector<vk::Image> Images;
+  // Only used in headless mode, where the images are owned by us rather than a swapchain.
+  std::vector<vk::UniqueImage> OffscreenImages;
+  std::vector<Allocation> OffscreenMemory;
   std::vector<vk::UniqueImageView> ImageViews;
   std::vector<vk::UniqueFramebuffer> Framebuffers;
   vk::Format DepthFormat;
   vk::UniqueImage DepthImage;
-  vk::UniqueDeviceMemory DepthMemory;
+  Allocation DepthMemory;
   vk::UniqueImageView DepthImageView;
 };
 
@@ -103,6 +158,7 @@ struct QueueFamilyInfo final {
 
 struct PhysicalDeviceInfo final {
   vk::PhysicalDeviceFeatures Features;
+  vk::PhysicalDeviceVulkan12Features Features12;
   vk::PhysicalDeviceMemoryProperties MemoryProperties;
   vk::PhysicalDeviceProperties Properties;
   std::vector<QueueFamilyInfo> QueueFamilies;
@@ -117,33 +173,101 @@ struct PhysicalDeviceInfo final {
   std::optional<uint32_t> PresentIndex;
 };
 
+struct FrameCapture final {
+  uint32_t Width{0};
+  uint32_t Height{0};
+  uint64_t Frame{0};
+  std::vector<uint8_t> Pixels;  // Tightly packed RGBA8
+};
+
 struct FrameData final {
+  // Binary semaphores for the swapchain, which cannot use timeline semaphores.
   vk::UniqueSemaphore PresentSemaphore;
   vk::UniqueSemaphore RenderSemaphore;
-  vk::UniqueFence RenderFence;
+  // The frame timeline value signalled when this frame's last submission completes.
+  uint64_t TimelineValue{0};
   vk::UniqueCommandPool CommandPool;
   vk::UniqueCommandBuffer MainCommandBuffer;
+  // One pool and secondary command buffer per recording thread. The pools are reset wholesale at
+  // the start of each frame rather than resetting their buffers individually.
+  std::vector<vk::UniqueCommandPool> RecordPools;
+  std::vector<vk::CommandBuffer> RecordCommandBuffers;
 
-  Buffer Global_CameraBuffer;
+  // Per-frame uniform data. The global set points at this buffer, and is bound with the offset of
+  // this frame's camera data.
+  UniformAllocator Uniforms;
+  uint32_t CameraOffset{0};
   vk::DescriptorSet GlobalSet;
+
+  // Copy of the scene's object data, bound at global set binding 1. Only objects whose transforms
+  // changed since this frame's last use are rewritten.
+  Buffer ObjectBuffer;
+  uint32_t ObjectCapacity{0};
+  uint64_t ObjectVersion{0};
+
+  // The object index of every instance drawn this frame, bound at global set binding 2. Written
+  // every frame, and looked up in the vertex shader with gl_InstanceIndex.
+  Buffer InstanceBuffer;
+  uint32_t InstanceCapacity{0};
+
+  // Written by the GPU culling pass, then consumed by the indirect draws. Rebuilt the first time
+  // this frame is used after the culling scene changes.
+  vk::DescriptorSet CullSet;
+  Buffer CullIndirectBuffer;
+  Buffer CullCountBuffer;
+  Buffer CullInstanceBuffer;
+  uint64_t CullSceneVersion{0};
+
+  // Reserved each frame. The opaque pass begins in the first draw range and ends in the last, which
+  // may be different command buffers.
+  GpuPass BackgroundPass;
+  GpuPass OpaquePass;
 };
 
 class Application final {
  public:
+  static constexpr uint32_t MaxFramesInFlight{4};
+  // Frames-in-flight presets. Low latency never lets the CPU get more than a frame ahead of the
+  // GPU, for interactive use. Throughput queues as deep as possible, for offline rendering.
+  static constexpr uint32_t LowLatencyFramesInFlight{1};
+  static constexpr uint32_t ThroughputFramesInFlight{MaxFramesInFlight};
+
   Application(const std::vector<const char*>& cmdArgs);
   ~Application();
 
   void Run();
 
+  // Request that the next rendered frame be read back into memory, and optionally saved as a PNG
+  // file. Only supported in headless mode.
+  void CaptureFrame(const std::string& path = "");
+  const FrameCapture& GetLastCapture() const noexcept;
+
  private:
   void Render();
+  void UpdateObjects(FrameData& frame);
+  void BuildBatches(FrameData& frame, const Frustum& frustum, const glm::vec3& cameraPosition);
+  void RecordDraws(vk::CommandBuffer cmd, const FrameData& frame,
+                   const std::vector<RenderBatch>& batches, size_t first, size_t last,
+                   bool background);
+  void UpdateCullScene(FrameData& frame);
+  void RebuildCullScene();
+  void RecordCulling(const vk::UniqueCommandBuffer& cmd, FrameData& frame, const Frustum& frustum);
+  void RecordCapture(const vk::UniqueCommandBuffer& cmd, uint32_t imageIndex);
+  void ResolveCapture(const FrameData& frame);
+  void WaitForFrame(const FrameData& frame);
+  void FinishTrace();
 
   void InitializeVulkan();
   void ShutdownVulkan();
   void SelectPhysicalDevice();
   void CreateDevice();
   void GetQueues() noexcept;
-  void CreateSwapchain();
+  void CreateSwapchain(vk::SwapchainKHR oldSwapchain = nullptr);
+  void RecreateSwapchain();
+  void ReleaseRetiredSwapchains();
+  void ReleaseRetiredBuffers();
+  void CreateOffscreenTargets();
+  void CreateDepthBuffer();
   void DestroySwapchain() noexcept;
   void CreateRenderPass();
   void CreateFramebuffers();
@@ -153,25 +277,56 @@ class Application final {
   void CreateCommandBuffers();
   void CreateSyncObjects();
   void CreateScene();
+  void CreateBenchmarkScene();
+  void WriteBenchmarkReport() const;
 
   Buffer CreateBuffer(const vk::DeviceSize size, vk::BufferUsageFlags usage,
                       vk::MemoryPropertyFlags memoryType);
-  Buffer CreateVertexBuffer(const std::vector<Vertex>& vertices);
-  std::shared_ptr<Mesh> LoadMesh(const std::string& path);
-  uint32_t FindMemoryType(uint32_t filter, vk::MemoryPropertyFlags properties);
+  Buffer CreateVertexBuffer(const void* vertices, vk::DeviceSize size);
+  Buffer CreateIndexBuffer(const void* indices, vk::DeviceSize size);
+  std::shared_ptr<Mesh> CreateMesh(const MeshData& data);
+  std::shared_ptr<Mesh> CreateMesh(const CookedMesh& cooked);
+  std::shared_ptr<Mesh> CreateMesh(const void* vertices, uint32_t vertexCount, const void* indices,
+                                   uint32_t indexCount, uint32_t indexSize,
+                                   const BoundingBox& bounds);
+  std::shared_ptr<Mesh> LoadMesh(const std::string& path, const MeshImportOptions& options = {});
+  // Returns a placeholder mesh immediately. The mesh is cooked on a worker thread, then uploaded
+  // and marked ready by ProcessPendingMeshes on the main thread.
+  std::shared_ptr<Mesh> LoadMeshAsync(const std::string& path,
+                                      const MeshImportOptions& options = {});
+  void ProcessPendingMeshes();
+  // Recompiles changed shader sources on worker threads, and reloads the ones that have finished so
+  // that the pipelines using them are rebuilt.
+  void ProcessShaderChanges();
+  // Thread safe, touches no Vulkan state.
+  bool CompileShader(const std::string& name);
+  // Thread safe, touches no Vulkan state.
+  bool CookMesh(const std::string& path, const MeshImportOptions& options, CookedMesh& cooked);
+  bool ParseMesh(const std::string& path, MeshData& data);
+  void OptimizeMesh(MeshData& data, const MeshImportOptions& options);
   vk::Format FindFormat(const std::vector<vk::Format>& candidates, vk::ImageTiling tiling,
                         vk::FormatFeatureFlags features);
-  vk::UniqueShaderModule CreateShaderModule(const std::string& path);
-  std::shared_ptr<Material> CreateMaterial(const std::shared_ptr<vk::UniquePipelineLayout> layout,
-                                           const std::shared_ptr<vk::UniquePipeline> pipeline,
-                                           const std::string& name);
-  std::shared_ptr<Material> GetMaterial(const std::string& name);
-  std::shared_ptr<Mesh> GetMesh(const std::string& name);
-
-  constexpr static const unsigned int FRAME_OVERLAP{2};
+  MaterialHandle CreateMaterial(const std::shared_ptr<vk::UniquePipelineLayout> layout,
+                                const std::shared_ptr<vk::UniquePipeline> pipeline,
+                                const std::string& name);
+  MaterialHandle GetMaterial(const std::string& name);
+  MeshHandle AddMesh(std::shared_ptr<Mesh> mesh, const std::string& name);
+  MeshHandle GetMesh(const std::string& name);
+
   bool mRunning{false};
   bool mValidation{true};
+  bool mHeadless{false};
+  bool mGpuCulling{false};
+  // Number of threads that record draws into secondary command buffers. Zero uses every worker.
+  uint32_t mRecordThreads{0};
+  vk::Extent2D mHeadlessExtent{1600, 900};
+  uint64_t mFrameLimit{0};
   uint64_t mCurrentFrame{0};
+  // Benchmark mode replaces the scene with a grid of this many instances when non-zero.
+  uint32_t mBenchmarkInstances{0};
+  std::string mBenchmarkReportPath{"Benchmark.json"};
+  // How many frames the CPU may record ahead of the GPU, from 1 to MaxFramesInFlight.
+  uint32_t mFramesInFlight{2};
   std::shared_ptr<Window> mWindow;
   vk::DynamicLoader mDynamicLoader;
   vk::UniqueInstance mInstance;
@@ -180,22 +335,101 @@ class Application final {
   vk::PhysicalDevice mPhysicalDevice;
   PhysicalDeviceInfo mDeviceInfo{};
   vk::UniqueDevice mDevice;
+  std::unique_ptr<DeviceAllocator> mAllocator;
+  std::unique_ptr<TransferManager> mTransfer;
   vk::Queue mGraphicsQueue;
   vk::Queue mPresentQueue;
   vk::Queue mTransferQueue;
   vk::Queue mComputeQueue;
   VulkanSwapchain mSwapchain{};
+  // Set when presentation reports the swapchain as suboptimal or out of date.
+  bool mSwapchainDirty{false};
+  // Swapchains replaced by a resize, kept alive until the frames using them have completed.
+  struct RetiredSwapchain {
+    uint64_t TimelineValue{0};
+    VulkanSwapchain Swapchain;
+  };
+  std::deque<RetiredSwapchain> mRetiredSwapchains;
   vk::UniqueRenderPass mRenderPass;
-  vk::UniquePipelineLayout mPipelineLayout;
-  vk::UniquePipelineLayout mTriPipelineLayout;
-  vk::UniquePipeline mBgPipeline;
-  vk::UniquePipeline mTriPipeline;
+  std::unique_ptr<PipelineCache> mPipelineCache;
+  std::unique_ptr<PipelineRegistry> mPipelines;
+  // Resource interfaces of the scene's graphics shaders and the culling shader, from reflection.
+  ShaderLayout mSceneShaders;
+  ShaderLayout mCullShaders;
   vk::UniqueDescriptorPool mDescriptorPool;
   vk::UniqueDescriptorSetLayout mGlobalSetLayout;
-  FrameData mFrames[FRAME_OVERLAP];
+  vk::UniqueDescriptorSetLayout mCullSetLayout;
+  vk::UniquePipelineLayout mCullPipelineLayout;
+  std::shared_ptr<vk::UniquePipeline> mCullPipeline;
+  std::vector<FrameData> mFrames;
+  // Signalled by every frame submission with an ever-increasing value.
+  vk::UniqueSemaphore mFrameTimeline;
+  uint64_t mFrameTimelineValue{0};
+  std::unique_ptr<GpuProfiler> mGpuProfiler;
+
+  bool mCaptureRequested{false};
+  std::string mCapturePath;
+  std::string mFinalCapturePath;
+  FrameCapture mLastCapture;
+  Buffer mReadbackBuffer;
+
+  // A CPU trace covers mTraceFrames frames starting at mTraceStart. Starting at frame 0 includes
+  // startup, and a frame count of 0 keeps tracing through shutdown.
+  std::string mTracePath;
+  uint64_t mTraceStart{0};
+  uint64_t mTraceFrames{0};
+
+  Scene mScene;
+  RenderQueue mRenderQueue;
+  // CPU culling scratch, reused every frame.
+  std::vector<uint32_t> mCullCandidates;
+  AabbList mCullBounds;
+  std::vector<uint8_t> mCullVisibility;
+  uint32_t mVisibleObjects{0};
+  uint32_t mCulledObjects{0};
+  std::vector<RenderBatch> mBatches;
+  // GPU culling state. Rebuilt whenever the set of drawable objects changes.
+  bool mCullSceneDirty{true};
+  size_t mCullSceneObjects{0};
+  uint64_t mCullSceneVersion{0};
+  uint32_t mCullObjectCount{0};
+  Buffer mCullObjects;
+  Buffer mCullDrawTemplate;
+  // Buffers replaced by a culling scene rebuild, kept alive until the frames using them have
+  // completed.
+  struct RetiredBuffers {
+    uint64_t TimelineValue{0};
+    std::vector<Buffer> Buffers;
+  };
+  std::deque<RetiredBuffers> mRetiredBuffers;
+  std::vector<RenderBatch> mCullBatches;
+  uint32_t mDrawCalls{0};
+  float mRecordMs{0.0f};
+  // Time spent in WaitForFrame since the last frame was added to mFrameStats.
+  float mWaitMs{0.0f};
+  FrameStats mFrameStats;
+  std::string mFrameStatsPath{"FrameStats.csv"};
+  std::unordered_map<std::string, MaterialHandle> mMaterials;
+  // Drawn in place of any material whose pipeline is still compiling.
+  MaterialHandle mPlaceholderMaterial{InvalidHandle};
+  std::unordered_map<std::string, MeshHandle> mMeshes;
 
-  std::vector<RenderObject> mRenderables;
-  std::unordered_map<std::string, std::shared_ptr<Material>> mMaterials;
-  std::unordered_map<std::string, std::shared_ptr<Mesh>> mMeshes;
+  struct PendingMesh {
+    std::shared_ptr<Mesh> Target;
+    std::unique_ptr<CookedMesh> Cooked;
+    std::string Path;
+  };
+  std::mutex mPendingMeshMutex;
+  std::vector<PendingMesh> mPendingMeshes;
+  std::unique_ptr<FileWatcher> mShaderWatcher;
+  // Shaders being compiled on a worker, and those changed again before their compile finished.
+  // Each shader has at most one compile in flight, so jobs never write over each other's output.
+  std::set<std::string> mCompilingShaders;
+  std::set<std::string> mRecompileShaders;
+  std::mutex mCompiledShaderMutex;
+  // Finished compiles, and whether each one succeeded.
+  std::vector<std::pair<std::string, bool>> mCompiledShaders;
+  // Declared last so that workers are joined before anything they might reference is destroyed.
+  std::unique_ptr<JobSystem> mJobs;
 };
 }  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,334 @@
+#include "Core.h"
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <glm/gtc/matrix_transform.hpp>
+#include <numeric>
+#include <random>
+
+#include "Application.h"
+#include "Frustum.h"
+#include "MeshProcessing.h"
+#include "RenderQueue.h"
+#include "Scene.h"
+
+namespace Raven {
+int RunCullingBenchmark(uint32_t objectCount, uint32_t iterations) {
+  Log::Info("[RunCullingBenchmark] Culling {} objects, {} iterations.", objectCount, iterations);
+
+  // Unit cubes scattered through a volume larger than the view, so that a good portion are culled.
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+  std::uniform_real_distribution<float> scale(0.1f, 2.0f);
+  const BoundingBox cube{glm::vec3(-1.0f), glm::vec3(1.0f)};
+
+  AabbList boxes;
+  for (uint32_t i = 0; i < objectCount; i++) {
+    const glm::mat4 transform{
+        glm::scale(glm::translate(glm::mat4(1.0f),
+                                  glm::vec3(position(rng), position(rng) * 0.1f, position(rng))),
+                   glm::vec3(scale(rng)))};
+    glm::vec3 center, extent;
+    TransformBounds(cube, transform, center, extent);
+    boxes.Push(center, extent);
+  }
+
+  const glm::mat4 view{glm::lookAt(glm::vec3(0, 4, -10), glm::vec3(0), glm::vec3(0, 1, 0))};
+  const glm::mat4 proj{glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f)};
+  const Frustum frustum{ExtractFrustum(proj * view)};
+
+  std::vector<uint8_t> scalarVisible(objectCount);
+  std::vector<uint8_t> simdVisible(objectCount);
+  size_t scalarCount{0};
+  size_t simdCount{0};
+
+  const auto timeNs{[&](auto&& cull) {
+    const auto start{std::chrono::high_resolution_clock::now()};
+    for (uint32_t i = 0; i < iterations; i++) {
+      cull();
+    }
+    const auto elapsed{std::chrono::high_resolution_clock::now() - start};
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           (static_cast<double>(iterations) * objectCount);
+  }};
+
+  const double scalarNs{
+      timeNs([&]() { scalarCount = CullAabbsScalar(frustum, boxes, scalarVisible.data()); })};
+  const double simdNs{timeNs([&]() { simdCount = CullAabbs(frustum, boxes, simdVisible.data()); })};
+
+  Log::Info("[RunCullingBenchmark] Visible: {}, culled: {}", simdCount, objectCount - simdCount);
+  Log::Info("[RunCullingBenchmark] Scalar: {:.2f}ns/object", scalarNs);
+  Log::Info("[RunCullingBenchmark] SIMD:   {:.2f}ns/object ({:.2f}x)", simdNs, scalarNs / simdNs);
+
+  if (scalarCount != simdCount || scalarVisible != simdVisible) {
+    Log::Error("[RunCullingBenchmark] SIMD and scalar culling results differ!");
+    return 1;
+  }
+
+  return 0;
+}
+
+int RunSceneBenchmark(uint32_t objectCount, uint32_t iterations) {
+  Log::Info("[RunSceneBenchmark] Batching {} objects, {} iterations.", objectCount, iterations);
+
+  constexpr uint32_t meshCount{16};
+  constexpr uint32_t materialCount{4};
+
+  // The layout the renderer used before Scene: one heap-linked object per renderable, sorted and
+  // batched by pointer.
+  struct LegacyObject {
+    std::shared_ptr<Raven::Mesh> Mesh;
+    std::shared_ptr<Raven::Material> Material;
+    glm::mat4 Transform;
+  };
+
+  Scene scene;
+  std::vector<std::shared_ptr<Mesh>> meshes;
+  std::vector<std::shared_ptr<Material>> materials;
+  for (uint32_t i = 0; i < meshCount; i++) {
+    auto mesh{std::make_shared<Mesh>()};
+    mesh->Bounds = {glm::vec3(-1.0f), glm::vec3(1.0f)};
+    mesh->Ready = true;
+    meshes.push_back(mesh);
+    scene.AddMesh(mesh);
+  }
+  for (uint32_t i = 0; i < materialCount; i++) {
+    materials.push_back(std::make_shared<Material>(nullptr, nullptr));
+    scene.AddMaterial(materials.back());
+  }
+
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+  std::uniform_int_distribution<uint32_t> meshDist(0, meshCount - 1);
+  std::uniform_int_distribution<uint32_t> materialDist(0, materialCount - 1);
+  std::vector<LegacyObject> legacy;
+  legacy.reserve(objectCount);
+  for (uint32_t i = 0; i < objectCount; i++) {
+    const uint32_t mesh{meshDist(rng)};
+    const uint32_t material{materialDist(rng)};
+    const glm::mat4 transform{glm::translate(
+        glm::mat4(1.0f), glm::vec3(position(rng), position(rng) * 0.1f, position(rng)))};
+    legacy.push_back({meshes[mesh], materials[material], transform});
+    scene.CreateObject(mesh, material, transform);
+  }
+
+  const glm::vec3 cameraPosition(0, 4, -10);
+  const glm::mat4 view{glm::lookAt(cameraPosition, glm::vec3(0), glm::vec3(0, 1, 0))};
+  const glm::mat4 proj{glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f)};
+  const Frustum frustum{ExtractFrustum(proj * view)};
+
+  // Both paths mirror Application::BuildBatches: cull, sort the survivors, then write instance
+  // data and split batches.
+  std::vector<uint32_t> candidates;
+  AabbList bounds;
+  std::vector<uint8_t> visibility(objectCount);
+  std::vector<uint32_t> order;
+  // The legacy path streamed a matrix per instance. The scene path writes object indices, and
+  // leaves transforms to the per-frame object buffer.
+  std::vector<glm::mat4> legacyInstances(objectCount);
+  std::vector<uint32_t> instances(objectCount);
+  std::vector<RenderBatch> batches;
+  RenderQueue queue;
+  const auto buildOrder{[&]() {
+    CullAabbs(frustum, bounds, visibility.data());
+    order.clear();
+    for (size_t i = 0; i < candidates.size(); i++) {
+      if (visibility[i]) {
+        order.push_back(candidates[i]);
+      }
+    }
+  }};
+
+  const auto timeNs{[&](auto&& build) {
+    const auto start{std::chrono::high_resolution_clock::now()};
+    for (uint32_t i = 0; i < iterations; i++) {
+      build();
+    }
+    const auto elapsed{std::chrono::high_resolution_clock::now() - start};
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           (static_cast<double>(iterations) * objectCount);
+  }};
+
+  const double legacyNs{timeNs([&]() {
+    candidates.clear();
+    bounds.Clear();
+    for (uint32_t i = 0; i < legacy.size(); i++) {
+      const LegacyObject& obj{legacy[i]};
+      if (obj.Mesh->Ready) {
+        glm::vec3 center, extent;
+        TransformBounds(obj.Mesh->Bounds, obj.Transform, center, extent);
+        bounds.Push(center, extent);
+        candidates.push_back(i);
+      }
+    }
+    buildOrder();
+    std::sort(order.begin(), order.end(), [&legacy](uint32_t a, uint32_t b) {
+      if (legacy[a].Material != legacy[b].Material) {
+        return legacy[a].Material < legacy[b].Material;
+      }
+      return legacy[a].Mesh < legacy[b].Mesh;
+    });
+
+    batches.clear();
+    for (uint32_t i = 0; i < order.size(); i++) {
+      const LegacyObject& obj{legacy[order[i]]};
+      legacyInstances[i] = obj.Transform;
+      if (batches.empty() || batches.back().Mesh != obj.Mesh.get() ||
+          batches.back().Material != obj.Material.get()) {
+        batches.push_back({obj.Mesh.get(), obj.Material.get(), i, 0});
+      }
+      batches.back().InstanceCount++;
+    }
+  })};
+  const size_t legacyBatches{batches.size()};
+
+  const double sceneNs{timeNs([&]() {
+    const std::vector<glm::mat4>& transforms{scene.Transforms()};
+    const std::vector<MeshHandle>& objectMeshes{scene.ObjectMeshes()};
+    const std::vector<MaterialHandle>& objectMaterials{scene.ObjectMaterials()};
+    const std::vector<uint64_t>& keys{scene.SortKeys()};
+
+    candidates.clear();
+    bounds.Clear();
+    for (uint32_t i = 0; i < scene.ObjectCount(); i++) {
+      const Mesh& mesh{scene.GetMesh(objectMeshes[i])};
+      if (mesh.Ready) {
+        glm::vec3 center, extent;
+        TransformBounds(mesh.Bounds, transforms[i], center, extent);
+        bounds.Push(center, extent);
+        candidates.push_back(i);
+      }
+    }
+    buildOrder();
+    queue.Clear();
+    for (const uint32_t object : order) {
+      const float distance{glm::length(glm::vec3(transforms[object][3]) - cameraPosition)};
+      queue.Push(keys[object] | QuantizeDepth(distance, 1000.0f), object);
+    }
+    queue.Sort();
+
+    batches.clear();
+    const std::vector<RenderQueue::Entry>& entries{queue.Entries()};
+    uint64_t lastState{std::numeric_limits<uint64_t>::max()};
+    for (uint32_t i = 0; i < entries.size(); i++) {
+      const uint32_t object{entries[i].Object};
+      instances[i] = object;
+      if (GetStateKey(entries[i].Key) != lastState) {
+        batches.push_back({&scene.GetMesh(objectMeshes[object]),
+                           &scene.GetMaterial(objectMaterials[object]), i, 0});
+        lastState = GetStateKey(entries[i].Key);
+      }
+      batches.back().InstanceCount++;
+    }
+  })};
+  const size_t sceneBatches{batches.size()};
+
+  Log::Info("[RunSceneBenchmark] Visible: {}, batches: {}", order.size(), sceneBatches);
+  Log::Info("[RunSceneBenchmark] Shared pointers: {:.2f}ns/object", legacyNs);
+  Log::Info("[RunSceneBenchmark] Scene handles:   {:.2f}ns/object ({:.2f}x)", sceneNs,
+            legacyNs / sceneNs);
+  const RenderQueueStats& unsorted{queue.UnsortedStats()};
+  const RenderQueueStats& sorted{queue.SortedStats()};
+  Log::Info("[RunSceneBenchmark] Binds unsorted: {} pipeline, {} descriptor set, {} mesh",
+            unsorted.PipelineBinds, unsorted.DescriptorSetBinds, unsorted.MeshBinds);
+  Log::Info("[RunSceneBenchmark] Binds sorted:   {} pipeline, {} descriptor set, {} mesh",
+            sorted.PipelineBinds, sorted.DescriptorSetBinds, sorted.MeshBinds);
+
+  if (legacyBatches != sceneBatches) {
+    Log::Error("[RunSceneBenchmark] Scene and legacy paths produced different batches!");
+    return 1;
+  }
+
+  return 0;
+}
+
+int RunMeshBenchmark(uint32_t triangleCount, uint32_t iterations) {
+  // A UV sphere with its triangles shuffled, standing in for an exported mesh with no useful order.
+  const uint32_t segments{std::max(
+      static_cast<uint32_t>(std::sqrt(static_cast<float>(triangleCount) / 2.0f)), 3u)};
+  std::vector<glm::vec3> positions;
+  for (uint32_t ring = 0; ring <= segments; ring++) {
+    const float theta{glm::pi<float>() * ring / segments};
+    for (uint32_t seg = 0; seg <= segments; seg++) {
+      const float phi{glm::two_pi<float>() * seg / segments};
+      positions.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta),
+                             std::sin(theta) * std::sin(phi));
+    }
+  }
+  std::vector<std::array<uint32_t, 3>> triangles;
+  for (uint32_t ring = 0; ring < segments; ring++) {
+    for (uint32_t seg = 0; seg < segments; seg++) {
+      const uint32_t a{ring * (segments + 1) + seg};
+      const uint32_t b{a + segments + 1};
+      triangles.push_back({a, b, a + 1});
+      triangles.push_back({a + 1, b, b + 1});
+    }
+  }
+  std::mt19937 rng(1234);
+  std::shuffle(triangles.begin(), triangles.end(), rng);
+  std::vector<uint32_t> indices;
+  for (const auto& triangle : triangles) {
+    indices.insert(indices.end(), triangle.begin(), triangle.end());
+  }
+  const size_t vertexCount{positions.size()};
+  Log::Info("[RunMeshBenchmark] Optimizing {} triangles, {} iterations.", triangles.size(),
+            iterations);
+
+  std::vector<uint32_t> cacheOptimized(indices.size());
+  std::vector<uint32_t> overdrawOptimized(indices.size());
+  const auto timeUs{[&](auto&& optimize) {
+    const auto start{std::chrono::high_resolution_clock::now()};
+    for (uint32_t i = 0; i < iterations; i++) {
+      optimize();
+    }
+    const auto elapsed{std::chrono::high_resolution_clock::now() - start};
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+  }};
+
+  const double cacheUs{timeUs([&]() {
+    OptimizeVertexCache(cacheOptimized.data(), indices.data(), indices.size(), vertexCount);
+  })};
+  const double overdrawUs{timeUs([&]() {
+    OptimizeOverdraw(overdrawOptimized.data(), cacheOptimized.data(), cacheOptimized.size(),
+                     &positions[0].x, sizeof(glm::vec3), vertexCount);
+  })};
+
+  const VertexCacheStats before{AnalyzeVertexCache(indices.data(), indices.size(), vertexCount)};
+  const VertexCacheStats cache{
+      AnalyzeVertexCache(cacheOptimized.data(), cacheOptimized.size(), vertexCount)};
+  const VertexCacheStats overdraw{
+      AnalyzeVertexCache(overdrawOptimized.data(), overdrawOptimized.size(), vertexCount)};
+  Log::Info("[RunMeshBenchmark] Unoptimized:   ACMR {:.3f}, ATVR {:.3f}", before.ACMR,
+            before.ATVR);
+  Log::Info("[RunMeshBenchmark] Vertex cache:  ACMR {:.3f}, ATVR {:.3f}, {:.2f}ms", cache.ACMR,
+            cache.ATVR, cacheUs / 1000.0);
+  Log::Info("[RunMeshBenchmark] Overdraw:      ACMR {:.3f}, ATVR {:.3f}, {:.2f}ms", overdraw.ACMR,
+            overdraw.ATVR, overdrawUs / 1000.0);
+
+  // Both passes only reorder whole triangles, keeping each one's winding.
+  const auto sortedTriangles{[](const std::vector<uint32_t>& source) {
+    std::vector<std::array<uint32_t, 3>> sorted(source.size() / 3);
+    for (size_t t = 0; t < sorted.size(); t++) {
+      sorted[t] = {source[t * 3 + 0], source[t * 3 + 1], source[t * 3 + 2]};
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  }};
+  const auto original{sortedTriangles(indices)};
+
+  int exitCode{0};
+  if (sortedTriangles(cacheOptimized) != original ||
+      sortedTriangles(overdrawOptimized) != original) {
+    Log::Error("[RunMeshBenchmark] Optimization changed the set of triangles!");
+    exitCode = 1;
+  }
+  if (cache.ACMR > before.ACMR || overdraw.ACMR > before.ACMR) {
+    Log::Error("[RunMeshBenchmark] Optimization made vertex cache efficiency worse!");
+    exitCode = 1;
+  }
+
+  return exitCode;
+}
+}  // namespace Raven
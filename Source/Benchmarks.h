@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Raven {
+// Standalone CPU benchmarks. These run before any window or Vulkan device is created, so they
+// work on machines without a GPU. Each returns a process exit code.
+int RunCullingBenchmark(uint32_t objectCount, uint32_t iterations);
+// Times the per-frame CPU work of turning the scene into instanced batches, comparing an array of
+// reference-counted objects against the Scene's flat arrays.
+int RunSceneBenchmark(uint32_t objectCount, uint32_t iterations);
+// Runs the vertex cache and overdraw optimizers over a shuffled sphere of roughly triangleCount
+// triangles, checking that they keep every triangle and do not raise ACMR.
+int RunMeshBenchmark(uint32_t triangleCount, uint32_t iterations);
+}  // namespace Raven
\ No newline at end of file
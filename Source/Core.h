@@ -3,11 +3,14 @@
 #define NOMINMAX
 
 #include <array>
+#include <cstddef>
+#include <cstring>
 #include <exception>
 #include <fmt/color.h>
 #include <fmt/core.h>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <set>
@@ -17,4 +20,5 @@
 #include <vector>
 
 #include "Log.h"
+#include "Profiler.h"
 #include "Win32.h"
\ No newline at end of file
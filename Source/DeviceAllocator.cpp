@@ -0,0 +1,323 @@
+#include "Core.h"
+
+#include "DeviceAllocator.h"
+
+namespace Raven {
+static vk::DeviceSize AlignUp(vk::DeviceSize value, vk::DeviceSize alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/* ==========================================================================================
+ * Allocation
+ * ========================================================================================== */
+
+Allocation::Allocation(Allocation&& o) noexcept { *this = std::move(o); }
+
+Allocation& Allocation::operator=(Allocation&& o) noexcept {
+  if (this != &o) {
+    Free();
+
+    Memory = o.Memory;
+    Offset = o.Offset;
+    Size = o.Size;
+    Mapped = o.Mapped;
+    mAllocator = o.mAllocator;
+    mBlock = o.mBlock;
+
+    o.Memory = nullptr;
+    o.Mapped = nullptr;
+    o.mAllocator = nullptr;
+    o.mBlock = nullptr;
+  }
+
+  return *this;
+}
+
+Allocation::~Allocation() { Free(); }
+
+void Allocation::Free() noexcept {
+  if (mAllocator) {
+    mAllocator->Free(*this);
+  }
+}
+
+/* ==========================================================================================
+ * Buffer
+ * ========================================================================================== */
+
+Buffer::Buffer(vk::UniqueBuffer buffer, Allocation&& memory, vk::DeviceSize size)
+    : Handle(std::move(buffer)), Memory(std::move(memory)), Size(size) {}
+
+Buffer::Buffer(Buffer&& o) {
+  Handle = std::move(o.Handle);
+  Memory = std::move(o.Memory);
+  Size = o.Size;
+}
+
+Buffer& Buffer::operator=(Buffer&& o) {
+  Handle = std::move(o.Handle);
+  Memory = std::move(o.Memory);
+  Size = o.Size;
+
+  return *this;
+}
+
+Buffer::~Buffer() {}
+
+/* ==========================================================================================
+ * DeviceAllocator
+ * ========================================================================================== */
+
+DeviceAllocator::DeviceAllocator(vk::Device device,
+                                 const vk::PhysicalDeviceMemoryProperties& memoryProperties,
+                                 vk::DeviceSize blockSize)
+    : mDevice(device), mMemoryProperties(memoryProperties), mBlockSize(blockSize) {
+  mPools.resize(mMemoryProperties.memoryTypeCount * 2);
+}
+
+DeviceAllocator::~DeviceAllocator() {
+  for (auto& pool : mPools) {
+    for (auto& block : pool) {
+      if (block->AllocationCount > 0) {
+        Log::Warn("[DeviceAllocator] Memory block destroyed with {} allocations still alive.",
+                  block->AllocationCount);
+      }
+      mDevice.freeMemory(block->Memory);
+    }
+  }
+}
+
+Allocation DeviceAllocator::Allocate(const vk::MemoryRequirements& requirements,
+                                     vk::MemoryPropertyFlags properties, bool linear) {
+  const uint32_t memoryType{FindMemoryType(requirements.memoryTypeBits, properties)};
+  Pool& pool{GetPool(memoryType, linear)};
+
+  // Small heaps (such as the 256MB host-visible device-local heap) should not be consumed by a
+  // single block.
+  const uint32_t heapIndex{mMemoryProperties.memoryTypes[memoryType].heapIndex};
+  const vk::DeviceSize blockSize{
+      std::min(mBlockSize, mMemoryProperties.memoryHeaps[heapIndex].size / 8)};
+
+  MemoryBlock* block{nullptr};
+  vk::DeviceSize offset{0};
+
+  if (requirements.size > blockSize / 2) {
+    block = CreateBlock(memoryType, requirements.size, linear, true);
+    block->FreeRanges.clear();
+  } else {
+    // Best fit across every block in the pool.
+    vk::DeviceSize bestWaste{std::numeric_limits<vk::DeviceSize>::max()};
+    for (auto& candidate : pool) {
+      if (candidate->Dedicated || candidate->Size - candidate->Used < requirements.size) {
+        continue;
+      }
+      for (const auto& [rangeOffset, rangeSize] : candidate->FreeRanges) {
+        const vk::DeviceSize aligned{AlignUp(rangeOffset, requirements.alignment)};
+        if (aligned + requirements.size > rangeOffset + rangeSize) {
+          continue;
+        }
+        const vk::DeviceSize waste{rangeSize - requirements.size};
+        if (waste < bestWaste) {
+          bestWaste = waste;
+          block = candidate.get();
+          offset = rangeOffset;
+        }
+      }
+    }
+
+    if (block == nullptr) {
+      block = CreateBlock(memoryType, blockSize, linear, false);
+      offset = 0;
+    }
+
+    // Carve the allocation out of the chosen range, returning any alignment padding and the
+    // remaining tail to the free list.
+    const auto range{block->FreeRanges.find(offset)};
+    const vk::DeviceSize rangeSize{range->second};
+    const vk::DeviceSize aligned{AlignUp(offset, requirements.alignment)};
+    block->FreeRanges.erase(range);
+    if (aligned > offset) {
+      block->FreeRanges[offset] = aligned - offset;
+    }
+    const vk::DeviceSize tail{offset + rangeSize - (aligned + requirements.size)};
+    if (tail > 0) {
+      block->FreeRanges[aligned + requirements.size] = tail;
+    }
+    offset = aligned;
+  }
+
+  block->Used += requirements.size;
+  block->AllocationCount++;
+
+  Allocation allocation;
+  allocation.Memory = block->Memory;
+  allocation.Offset = offset;
+  allocation.Size = requirements.size;
+  allocation.Mapped = block->Mapped ? static_cast<uint8_t*>(block->Mapped) + offset : nullptr;
+  allocation.mAllocator = this;
+  allocation.mBlock = block;
+
+  return allocation;
+}
+
+Allocation DeviceAllocator::AllocateBuffer(vk::Buffer buffer, vk::MemoryPropertyFlags properties) {
+  const vk::MemoryRequirements requirements{mDevice.getBufferMemoryRequirements(buffer)};
+  Allocation allocation{Allocate(requirements, properties, true)};
+  mDevice.bindBufferMemory(buffer, allocation.Memory, allocation.Offset);
+
+  return allocation;
+}
+
+Allocation DeviceAllocator::AllocateImage(vk::Image image, vk::MemoryPropertyFlags properties) {
+  const vk::MemoryRequirements requirements{mDevice.getImageMemoryRequirements(image)};
+  Allocation allocation{Allocate(requirements, properties, false)};
+  mDevice.bindImageMemory(image, allocation.Memory, allocation.Offset);
+
+  return allocation;
+}
+
+Buffer DeviceAllocator::CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage,
+                                     vk::MemoryPropertyFlags properties) {
+  const vk::BufferCreateInfo bufferCI({}, size, usage);
+  vk::UniqueBuffer buffer{mDevice.createBufferUnique(bufferCI)};
+  Allocation memory{AllocateBuffer(*buffer, properties)};
+
+  return Buffer(std::move(buffer), std::move(memory), size);
+}
+
+uint32_t DeviceAllocator::FindMemoryType(uint32_t filter,
+                                         vk::MemoryPropertyFlags properties) const {
+  for (uint32_t i = 0; i < mMemoryProperties.memoryTypeCount; i++) {
+    if ((filter & (1 << i)) &&
+        (mMemoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+      return i;
+    }
+  }
+
+  throw std::runtime_error("No memory type is available that meets requirements!");
+}
+
+AllocatorStats DeviceAllocator::GetStats() const noexcept {
+  AllocatorStats stats;
+  for (const auto& pool : mPools) {
+    for (const auto& block : pool) {
+      if (block->Dedicated) {
+        stats.DedicatedBlockCount++;
+      } else {
+        stats.BlockCount++;
+      }
+      stats.AllocationCount += block->AllocationCount;
+      stats.ReservedBytes += block->Size;
+      stats.UsedBytes += block->Used;
+      for (const auto& [offset, size] : block->FreeRanges) {
+        stats.FreeRangeCount++;
+        stats.FreeBytes += size;
+        stats.LargestFreeRange = std::max(stats.LargestFreeRange, size);
+      }
+    }
+  }
+
+  return stats;
+}
+
+void DeviceAllocator::LogStats() const {
+  const AllocatorStats stats{GetStats()};
+  Log::Debug("[DeviceAllocator] {} allocations in {} blocks (+{} dedicated)",
+             stats.AllocationCount, stats.BlockCount, stats.DedicatedBlockCount);
+  Log::Debug("[DeviceAllocator] - Reserved: {:.2f}MB, Used: {:.2f}MB, Free: {:.2f}MB",
+             stats.ReservedBytes / 1024.0f / 1024.0f, stats.UsedBytes / 1024.0f / 1024.0f,
+             stats.FreeBytes / 1024.0f / 1024.0f);
+  Log::Debug("[DeviceAllocator] - {} free ranges, largest {:.2f}MB, fragmentation {:.1f}%",
+             stats.FreeRangeCount, stats.LargestFreeRange / 1024.0f / 1024.0f,
+             stats.Fragmentation() * 100.0f);
+}
+
+MemoryBlock* DeviceAllocator::CreateBlock(uint32_t memoryType, vk::DeviceSize size, bool linear,
+                                          bool dedicated) {
+  auto block{std::make_unique<MemoryBlock>()};
+  block->Memory = mDevice.allocateMemory(vk::MemoryAllocateInfo(size, memoryType));
+  block->Size = size;
+  block->MemoryType = memoryType;
+  block->Linear = linear;
+  block->Dedicated = dedicated;
+  block->FreeRanges[0] = size;
+
+  // Host-visible blocks stay mapped for their entire lifetime. A block can only be mapped once,
+  // so individual allocations hand out pointers into this mapping instead.
+  if (mMemoryProperties.memoryTypes[memoryType].propertyFlags &
+      vk::MemoryPropertyFlagBits::eHostVisible) {
+    block->Mapped = mDevice.mapMemory(block->Memory, 0, VK_WHOLE_SIZE);
+  }
+
+  Log::Trace("[DeviceAllocator] Allocated {}{:.2f}MB block from memory type {}.",
+             dedicated ? "dedicated " : "", size / 1024.0f / 1024.0f, memoryType);
+
+  Pool& pool{GetPool(memoryType, linear)};
+  pool.push_back(std::move(block));
+
+  return pool.back().get();
+}
+
+void DeviceAllocator::DestroyBlock(MemoryBlock* block) noexcept {
+  Pool& pool{GetPool(block->MemoryType, block->Linear)};
+  for (auto it = pool.begin(); it != pool.end(); it++) {
+    if (it->get() == block) {
+      mDevice.freeMemory(block->Memory);
+      pool.erase(it);
+      return;
+    }
+  }
+}
+
+void DeviceAllocator::Free(Allocation& allocation) noexcept {
+  MemoryBlock* block{allocation.mBlock};
+  block->Used -= allocation.Size;
+  block->AllocationCount--;
+
+  allocation.Memory = nullptr;
+  allocation.Mapped = nullptr;
+  allocation.mAllocator = nullptr;
+  allocation.mBlock = nullptr;
+
+  if (block->Dedicated) {
+    DestroyBlock(block);
+    return;
+  }
+
+  // Return the range to the free list, merging it with its neighbours.
+  vk::DeviceSize offset{allocation.Offset};
+  vk::DeviceSize size{allocation.Size};
+  auto next{block->FreeRanges.lower_bound(offset)};
+  if (next != block->FreeRanges.end() && offset + size == next->first) {
+    size += next->second;
+    next = block->FreeRanges.erase(next);
+  }
+  if (next != block->FreeRanges.begin()) {
+    auto prev{std::prev(next)};
+    if (prev->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+      block->FreeRanges.erase(prev);
+    }
+  }
+  block->FreeRanges[offset] = size;
+
+  // Keep one empty block around per pool so that churn does not hit vkAllocateMemory.
+  if (block->AllocationCount == 0) {
+    const Pool& pool{GetPool(block->MemoryType, block->Linear)};
+    uint32_t emptyBlocks{0};
+    for (const auto& b : pool) {
+      if (!b->Dedicated && b->AllocationCount == 0) {
+        emptyBlocks++;
+      }
+    }
+    if (emptyBlocks > 1) {
+      DestroyBlock(block);
+    }
+  }
+}
+
+DeviceAllocator::Pool& DeviceAllocator::GetPool(uint32_t memoryType, bool linear) {
+  return mPools[memoryType * 2 + (linear ? 0 : 1)];
+}
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "VulkanCore.h"
+
+namespace Raven {
+class DeviceAllocator;
+struct MemoryBlock;
+
+// A sub-allocated range of device memory. Owned ranges are returned to their allocator when the
+// Allocation is destroyed.
+class Allocation final {
+ public:
+  Allocation() {}
+  Allocation(const Allocation&) = delete;
+  Allocation(Allocation&& o) noexcept;
+  Allocation& operator=(Allocation&& o) noexcept;
+  ~Allocation();
+
+  explicit operator bool() const noexcept { return mAllocator != nullptr; }
+  void Free() noexcept;
+
+  vk::DeviceMemory Memory;
+  vk::DeviceSize Offset{0};
+  vk::DeviceSize Size{0};
+  // Persistent mapping of this range, or nullptr if the memory is not host visible.
+  void* Mapped{nullptr};
+
+ private:
+  friend class DeviceAllocator;
+
+  DeviceAllocator* mAllocator{nullptr};
+  MemoryBlock* mBlock{nullptr};
+};
+
+class Buffer {
+ public:
+  Buffer() {}
+  Buffer(vk::UniqueBuffer buffer, Allocation&& memory, vk::DeviceSize size);
+  Buffer(const Buffer&) = delete;
+  Buffer(Buffer&& o);
+  Buffer& operator=(Buffer&& o);
+  ~Buffer();
+
+  vk::UniqueBuffer Handle;
+  Allocation Memory;
+  vk::DeviceSize Size{0};
+};
+
+struct AllocatorStats final {
+  uint32_t BlockCount{0};
+  uint32_t DedicatedBlockCount{0};
+  uint32_t AllocationCount{0};
+  uint32_t FreeRangeCount{0};
+  vk::DeviceSize ReservedBytes{0};
+  vk::DeviceSize UsedBytes{0};
+  vk::DeviceSize FreeBytes{0};
+  vk::DeviceSize LargestFreeRange{0};
+
+  // 0 when all free space is contiguous, approaching 1 as it is split into many small ranges.
+  float Fragmentation() const noexcept {
+    return FreeBytes == 0 ? 0.0f
+                          : 1.0f - static_cast<float>(LargestFreeRange) /
+                                       static_cast<float>(FreeBytes);
+  }
+};
+
+struct MemoryBlock final {
+  vk::DeviceMemory Memory;
+  vk::DeviceSize Size{0};
+  vk::DeviceSize Used{0};
+  uint32_t MemoryType{0};
+  uint32_t AllocationCount{0};
+  bool Linear{true};
+  bool Dedicated{false};
+  void* Mapped{nullptr};
+  std::map<vk::DeviceSize, vk::DeviceSize> FreeRanges;  // Offset -> Size
+};
+
+// Sub-allocates buffers and images out of large vk::DeviceMemory blocks, keyed by memory type.
+// Linear (buffer) and optimal (image) resources are kept in separate pools so that
+// bufferImageGranularity never has to be considered.
+class DeviceAllocator final {
+ public:
+  DeviceAllocator(vk::Device device, const vk::PhysicalDeviceMemoryProperties& memoryProperties,
+                  vk::DeviceSize blockSize = 64 * 1024 * 1024);
+  DeviceAllocator(const DeviceAllocator&) = delete;
+  ~DeviceAllocator();
+
+  Allocation Allocate(const vk::MemoryRequirements& requirements,
+                      vk::MemoryPropertyFlags properties, bool linear);
+  Allocation AllocateBuffer(vk::Buffer buffer, vk::MemoryPropertyFlags properties);
+  Allocation AllocateImage(vk::Image image, vk::MemoryPropertyFlags properties);
+  Buffer CreateBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage,
+                      vk::MemoryPropertyFlags properties);
+
+  uint32_t FindMemoryType(uint32_t filter, vk::MemoryPropertyFlags properties) const;
+  AllocatorStats GetStats() const noexcept;
+  void LogStats() const;
+
+ private:
+  friend class Allocation;
+
+  using Pool = std::vector<std::unique_ptr<MemoryBlock>>;
+
+  MemoryBlock* CreateBlock(uint32_t memoryType, vk::DeviceSize size, bool linear, bool dedicated);
+  void DestroyBlock(MemoryBlock* block) noexcept;
+  void Free(Allocation& allocation) noexcept;
+  Pool& GetPool(uint32_t memoryType, bool linear);
+
+  vk::Device mDevice;
+  vk::PhysicalDeviceMemoryProperties mMemoryProperties;
+  vk::DeviceSize mBlockSize;
+  std::vector<Pool> mPools;  // Indexed by (memoryType * 2) + (linear ? 0 : 1)
+};
+}  // namespace Raven
\ No newline at end of file
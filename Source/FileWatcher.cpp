@@ -0,0 +1,100 @@
+#include "Core.h"
+
+#include "FileWatcher.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Raven {
+#ifndef __linux__
+// Scanning the directory is cheap, but not cheap enough to do every frame.
+constexpr static std::chrono::milliseconds gScanInterval{250};
+#endif
+
+FileWatcher::FileWatcher(const std::string& directory) : mDirectory(directory) {
+#ifdef __linux__
+  mInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (mInotify < 0) {
+    Log::Warn("[FileWatcher] Failed to initialize inotify.");
+    return;
+  }
+  // Editors either write files in place or write a temporary file and rename it over the original.
+  if (inotify_add_watch(mInotify, mDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    Log::Warn("[FileWatcher] Failed to watch {}.", mDirectory);
+    return;
+  }
+#else
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(mDirectory, error)) {
+    mWriteTimes[entry.path().filename().string()] = entry.last_write_time(error);
+  }
+  if (error) {
+    Log::Warn("[FileWatcher] Failed to watch {}.", mDirectory);
+    return;
+  }
+  mLastScan = std::chrono::steady_clock::now();
+#endif
+  mValid = true;
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+  if (mInotify >= 0) {
+    close(mInotify);
+  }
+#endif
+}
+
+std::vector<std::string> FileWatcher::Poll() {
+  std::vector<std::string> changed;
+  if (!mValid) {
+    return changed;
+  }
+
+#ifdef __linux__
+  alignas(inotify_event) char buffer[4096];
+  while (true) {
+    const ssize_t size{read(mInotify, buffer, sizeof(buffer))};
+    if (size <= 0) {
+      break;
+    }
+    for (ssize_t offset = 0; offset < size;) {
+      const inotify_event* event{reinterpret_cast<const inotify_event*>(buffer + offset)};
+      if (event->len > 0) {
+        changed.emplace_back(event->name);
+      }
+      offset += sizeof(inotify_event) + event->len;
+    }
+  }
+#else
+  const auto now{std::chrono::steady_clock::now()};
+  if (now - mLastScan < gScanInterval) {
+    return changed;
+  }
+  mLastScan = now;
+
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(mDirectory, error)) {
+    const auto writeTime{entry.last_write_time(error)};
+    if (error) {
+      continue;
+    }
+    auto& lastWriteTime{mWriteTimes[entry.path().filename().string()]};
+    if (writeTime != lastWriteTime) {
+      lastWriteTime = writeTime;
+      changed.push_back(entry.path().filename().string());
+    }
+  }
+#endif
+
+  // A single save often produces several events.
+  std::sort(changed.begin(), changed.end());
+  changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+  return changed;
+}
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#ifndef __linux__
+#include <filesystem>
+#include <unordered_map>
+#endif
+
+namespace Raven {
+// Reports files in a directory that have been written since the last poll. Uses inotify on Linux,
+// and compares modification times everywhere else.
+class FileWatcher final {
+ public:
+  explicit FileWatcher(const std::string& directory);
+  FileWatcher(const FileWatcher&) = delete;
+  ~FileWatcher();
+
+  // Never blocks. Returns the names of changed files, relative to the watched directory.
+  std::vector<std::string> Poll();
+
+  explicit operator bool() const noexcept { return mValid; }
+
+ private:
+  std::string mDirectory;
+  bool mValid{false};
+#ifdef __linux__
+  int mInotify{-1};
+#else
+  std::unordered_map<std::string, std::filesystem::file_time_type> mWriteTimes;
+  std::chrono::steady_clock::time_point mLastScan;
+#endif
+};
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "Core.h"
+
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Raven {
+constexpr static size_t gHistogramBuckets{9};
+
+// Nearest-rank percentile of sorted samples.
+static float Percentile(const std::vector<float>& sorted, double percentile) {
+  const size_t rank{static_cast<size_t>(std::ceil(sorted.size() * percentile))};
+
+  return sorted[std::min(std::max(rank, size_t{1}), sorted.size()) - 1];
+}
+
+static FrameTimeStats ComputeStats(std::vector<float>& samples) {
+  FrameTimeStats stats;
+  // Missing measurements are recorded as NaN, and left out of the statistics.
+  samples.erase(
+      std::remove_if(samples.begin(), samples.end(), [](float ms) { return std::isnan(ms); }),
+      samples.end());
+  if (samples.empty()) {
+    return stats;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  stats.Samples = samples.size();
+  double sum{0.0};
+  for (const float ms : samples) {
+    sum += ms;
+  }
+  stats.AvgMs = static_cast<float>(sum / samples.size());
+  stats.P50Ms = Percentile(samples, 0.50);
+  stats.P95Ms = Percentile(samples, 0.95);
+  stats.P99Ms = Percentile(samples, 0.99);
+  stats.MaxMs = samples.back();
+
+  return stats;
+}
+
+FrameStats::FrameStats(float budgetMs, size_t windowFrames, size_t historyFrames)
+    : mBudgetMs(budgetMs),
+      mWindowFrames(std::min(windowFrames, historyFrames)),
+      mHistoryFrames(historyFrames) {}
+
+void FrameStats::AddFrame(const FrameSample& sample) {
+  if (mSamples.size() < mHistoryFrames) {
+    mSamples.push_back(sample);
+  } else {
+    mSamples[mNext] = sample;
+  }
+  mNext = (mNext + 1) % mHistoryFrames;
+  mRunFrames++;
+  if (sample.CpuMs > mBudgetMs) {
+    mRunHitches++;
+  }
+
+  if (mCsv.is_open()) {
+    // Unmeasured GPU times are left empty rather than written as NaN.
+    mCsv << fmt::format("{},{:.4f},{},{:.4f},{}\n", mCsvFrames++, sample.CpuMs,
+                        std::isnan(sample.GpuMs) ? "" : fmt::format("{:.4f}", sample.GpuMs),
+                        sample.WaitMs, sample.CpuMs > mBudgetMs ? 1 : 0);
+  }
+}
+
+void FrameStats::Reset() noexcept {
+  mSamples.clear();
+  mNext = 0;
+  mRunFrames = 0;
+  mRunHitches = 0;
+}
+
+FrameStatsSummary FrameStats::GetWindowStats() const {
+  return Summarize(std::min(mSamples.size(), mWindowFrames));
+}
+
+FrameStatsSummary FrameStats::GetRunStats() const {
+  FrameStatsSummary summary{Summarize(mSamples.size())};
+  summary.Frames = mRunFrames;
+  summary.Hitches = mRunHitches;
+
+  return summary;
+}
+
+std::vector<uint64_t> FrameStats::GetHistogram() const {
+  std::vector<uint64_t> histogram(gHistogramBuckets, 0);
+  const float bucketMs{mBudgetMs / 4.0f};
+  for (const auto& sample : mSamples) {
+    const size_t bucket{static_cast<size_t>(sample.CpuMs / bucketMs)};
+    histogram[std::min(bucket, gHistogramBuckets - 1)]++;
+  }
+
+  return histogram;
+}
+
+void FrameStats::LogStats() const {
+  const FrameStatsSummary stats{GetRunStats()};
+  if (stats.Frames == 0) {
+    return;
+  }
+
+  const auto logTimes{[](const char* name, const FrameTimeStats& times) {
+    if (times.Samples > 0) {
+      Log::Info("[FrameStats] {}: avg {:.3f}ms, p50 {:.3f}ms, p95 {:.3f}ms, p99 {:.3f}ms, "
+                "max {:.3f}ms",
+                name, times.AvgMs, times.P50Ms, times.P95Ms, times.P99Ms, times.MaxMs);
+    }
+  }};
+  Log::Info("[FrameStats] {} frames, {} over the {:.2f}ms budget ({:.2f}%)", stats.Frames,
+            stats.Hitches, mBudgetMs, stats.Hitches * 100.0f / stats.Frames);
+  logTimes("CPU", stats.Cpu);
+  logTimes("GPU", stats.Gpu);
+  logTimes("Wait", stats.Wait);
+
+  const std::vector<uint64_t> histogram{GetHistogram()};
+  const uint64_t largest{*std::max_element(histogram.begin(), histogram.end())};
+  for (size_t i = 0; i < histogram.size(); i++) {
+    const float lower{mBudgetMs * i / 4.0f};
+    const std::string range{i + 1 < histogram.size()
+                                ? fmt::format("{:6.2f}-{:6.2f}ms", lower, lower + mBudgetMs / 4.0f)
+                                : fmt::format("{:6.2f}ms+       ", lower)};
+    const size_t bar{static_cast<size_t>(histogram[i] * 40 / largest)};
+    Log::Debug("[FrameStats] {} {:8} {}", range, histogram[i], std::string(bar, '#'));
+  }
+}
+
+bool FrameStats::OpenCsv(const std::string& path) {
+  CloseCsv();
+  mCsv.open(path, std::ios::out | std::ios::trunc);
+  if (!mCsv.is_open()) {
+    Log::Error("[FrameStats] Failed to open {} for writing.", path);
+    return false;
+  }
+
+  mCsvPath = path;
+  mCsvFrames = 0;
+  mCsv << "Frame,CpuMs,GpuMs,WaitMs,Hitch\n";
+
+  return true;
+}
+
+void FrameStats::CloseCsv() {
+  if (!mCsv.is_open()) {
+    return;
+  }
+
+  mCsv.close();
+  if (mCsv.fail()) {
+    Log::Error("[FrameStats] Failed to write frame statistics to {}.", mCsvPath);
+  } else {
+    Log::Info("[FrameStats] Wrote {} frames to {}.", mCsvFrames, mCsvPath);
+  }
+}
+
+FrameStatsSummary FrameStats::Summarize(size_t count) const {
+  FrameStatsSummary summary;
+  summary.Frames = count;
+
+  std::vector<float> cpu;
+  std::vector<float> gpu;
+  std::vector<float> wait;
+  cpu.reserve(count);
+  gpu.reserve(count);
+  wait.reserve(count);
+  // The newest frame sits just before mNext, wrapping around the ring.
+  for (size_t i = 0; i < count; i++) {
+    const FrameSample& sample{mSamples[(mNext + mHistoryFrames - count + i) % mHistoryFrames]};
+    cpu.push_back(sample.CpuMs);
+    gpu.push_back(sample.GpuMs);
+    wait.push_back(sample.WaitMs);
+    if (sample.CpuMs > mBudgetMs) {
+      summary.Hitches++;
+    }
+  }
+  summary.Cpu = ComputeStats(cpu);
+  summary.Gpu = ComputeStats(gpu);
+  summary.Wait = ComputeStats(wait);
+
+  return summary;
+}
+}  // namespace Raven
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Raven {
+struct FrameSample {
+  // Wall time between the starts of consecutive frames.
+  float CpuMs{0.0f};
+  // Whole-frame GPU time, or NaN if it was not measured.
+  float GpuMs{0.0f};
+  // Time spent blocked waiting for the GPU to release a frame in flight.
+  float WaitMs{0.0f};
+};
+
+struct FrameTimeStats {
+  uint64_t Samples{0};
+  float AvgMs{0.0f};
+  float P50Ms{0.0f};
+  float P95Ms{0.0f};
+  float P99Ms{0.0f};
+  float MaxMs{0.0f};
+};
+
+struct FrameStatsSummary {
+  uint64_t Frames{0};
+  // Frames whose CPU time exceeded the frame budget.
+  uint64_t Hitches{0};
+  FrameTimeStats Cpu;
+  FrameTimeStats Gpu;
+  FrameTimeStats Wait;
+};
+
+// Records the timing of every frame. Percentiles are available both over a rolling window of
+// recent frames, for display, and over the run, for reports. Run percentiles cover the most recent
+// historyFrames frames, at 12 bytes each, while frame and hitch counts cover the whole run. Every
+// frame is also streamed to a CSV file as it is added, if one is open.
+class FrameStats final {
+ public:
+  explicit FrameStats(float budgetMs = 1000.0f / 60.0f, size_t windowFrames = 1000,
+                      size_t historyFrames = 1 << 20);
+
+  void AddFrame(const FrameSample& sample);
+  // Starts the run statistics over. Frames already written to the CSV file stay there.
+  void Reset() noexcept;
+
+  FrameStatsSummary GetWindowStats() const;
+  FrameStatsSummary GetRunStats() const;
+  // Counts CPU frame times across the run history in buckets of a quarter of the budget. The last
+  // bucket holds every frame of twice the budget or more.
+  std::vector<uint64_t> GetHistogram() const;
+  void LogStats() const;
+  bool OpenCsv(const std::string& path);
+  void CloseCsv();
+
+  float Budget() const noexcept { return mBudgetMs; }
+  void SetBudget(float budgetMs) noexcept { mBudgetMs = budgetMs; }
+
+ private:
+  // Summarizes the most recent count frames of the history.
+  FrameStatsSummary Summarize(size_t count) const;
+
+  float mBudgetMs;
+  size_t mWindowFrames;
+  size_t mHistoryFrames;
+  // Ring of recent frames, with mNext the slot the next frame is written to.
+  std::vector<FrameSample> mSamples;
+  size_t mNext{0};
+  uint64_t mRunFrames{0};
+  uint64_t mRunHitches{0};
+
+  std::ofstream mCsv;
+  std::string mCsvPath;
+  uint64_t mCsvFrames{0};
+};
+}  // namespace Raven
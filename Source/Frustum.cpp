@@ -0,0 +1,140 @@
+#include "Core.h"
+
+#include "Frustum.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAVEN_FRUSTUM_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace Raven {
+void AabbList::Clear() noexcept {
+  CenterX.clear();
+  CenterY.clear();
+  CenterZ.clear();
+  ExtentX.clear();
+  ExtentY.clear();
+  ExtentZ.clear();
+}
+
+void AabbList::Push(const glm::vec3& center, const glm::vec3& extent) {
+  CenterX.push_back(center.x);
+  CenterY.push_back(center.y);
+  CenterZ.push_back(center.z);
+  ExtentX.push_back(extent.x);
+  ExtentY.push_back(extent.y);
+  ExtentZ.push_back(extent.z);
+}
+
+Frustum ExtractFrustum(const glm::mat4& viewProj) {
+  // Gribb/Hartmann plane extraction. glm matrices are column-major, so gather the rows first.
+  const glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+  const glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+  const glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+  const glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+
+  // The near plane assumes an OpenGL style -w..w depth range. Vulkan's 0..w range only makes it
+  // slightly conservative.
+  Frustum frustum;
+  frustum.Planes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+  for (auto& plane : frustum.Planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+
+  return frustum;
+}
+
+void TransformBounds(const BoundingBox& bounds, const glm::mat4& transform, glm::vec3& center,
+                     glm::vec3& extent) {
+  const glm::vec3 localCenter{(bounds.Min + bounds.Max) * 0.5f};
+  const glm::vec3 localExtent{(bounds.Max - bounds.Min) * 0.5f};
+
+  center = glm::vec3(transform * glm::vec4(localCenter, 1.0f));
+  const glm::mat3 absTransform(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])),
+                               glm::abs(glm::vec3(transform[2])));
+  extent = absTransform * localExtent;
+}
+
+// A box is outside a plane when its center is further behind the plane than the box's projected
+// radius onto the plane normal.
+static bool AabbVisible(const Frustum& frustum, const AabbList& boxes, size_t i) {
+  for (const auto& plane : frustum.Planes) {
+    const float distance{plane.x * boxes.CenterX[i] + plane.y * boxes.CenterY[i] +
+                         plane.z * boxes.CenterZ[i] + plane.w};
+    const float radius{std::abs(plane.x) * boxes.ExtentX[i] + std::abs(plane.y) * boxes.ExtentY[i] +
+                       std::abs(plane.z) * boxes.ExtentZ[i]};
+    if (distance + radius < 0.0f) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+size_t CullAabbsScalar(const Frustum& frustum, const AabbList& boxes, uint8_t* visible) {
+  size_t visibleCount{0};
+  for (size_t i = 0; i < boxes.Size(); i++) {
+    visible[i] = AabbVisible(frustum, boxes, i) ? 1 : 0;
+    visibleCount += visible[i];
+  }
+
+  return visibleCount;
+}
+
+size_t CullAabbs(const Frustum& frustum, const AabbList& boxes, uint8_t* visible) {
+#ifdef RAVEN_FRUSTUM_SSE
+  const size_t count{boxes.Size()};
+  const size_t simdCount{count & ~size_t(3)};
+  size_t visibleCount{0};
+
+  // Splat every plane once up front. Absolute values of the normals are precomputed for the
+  // radius term.
+  __m128 planeX[6], planeY[6], planeZ[6], planeW[6], absX[6], absY[6], absZ[6];
+  for (size_t p = 0; p < 6; p++) {
+    const glm::vec4& plane{frustum.Planes[p]};
+    planeX[p] = _mm_set1_ps(plane.x);
+    planeY[p] = _mm_set1_ps(plane.y);
+    planeZ[p] = _mm_set1_ps(plane.z);
+    planeW[p] = _mm_set1_ps(plane.w);
+    absX[p] = _mm_set1_ps(std::abs(plane.x));
+    absY[p] = _mm_set1_ps(std::abs(plane.y));
+    absZ[p] = _mm_set1_ps(std::abs(plane.z));
+  }
+  const __m128 zero{_mm_setzero_ps()};
+
+  for (size_t i = 0; i < simdCount; i += 4) {
+    const __m128 cx{_mm_loadu_ps(&boxes.CenterX[i])};
+    const __m128 cy{_mm_loadu_ps(&boxes.CenterY[i])};
+    const __m128 cz{_mm_loadu_ps(&boxes.CenterZ[i])};
+    const __m128 ex{_mm_loadu_ps(&boxes.ExtentX[i])};
+    const __m128 ey{_mm_loadu_ps(&boxes.ExtentY[i])};
+    const __m128 ez{_mm_loadu_ps(&boxes.ExtentZ[i])};
+
+    __m128 outside{zero};
+    for (size_t p = 0; p < 6; p++) {
+      const __m128 distance{_mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy)),
+          _mm_add_ps(_mm_mul_ps(planeZ[p], cz), planeW[p]))};
+      const __m128 radius{_mm_add_ps(_mm_add_ps(_mm_mul_ps(absX[p], ex), _mm_mul_ps(absY[p], ey)),
+                                     _mm_mul_ps(absZ[p], ez))};
+      outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+    }
+
+    const int outsideMask{_mm_movemask_ps(outside)};
+    for (size_t lane = 0; lane < 4; lane++) {
+      visible[i + lane] = (outsideMask >> lane) & 1 ? 0 : 1;
+      visibleCount += visible[i + lane];
+    }
+  }
+
+  for (size_t i = simdCount; i < count; i++) {
+    visible[i] = AabbVisible(frustum, boxes, i) ? 1 : 0;
+    visibleCount += visible[i];
+  }
+
+  return visibleCount;
+#else
+  return CullAabbsScalar(frustum, boxes, visible);
+#endif
+}
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "MeshProcessing.h"
+
+namespace Raven {
+// View frustum as six inward-facing planes (xyz = normal, w = distance), in the order left, right,
+// bottom, top, near, far. A point p is inside a plane when dot(plane.xyz, p) + plane.w >= 0.
+struct Frustum {
+  std::array<glm::vec4, 6> Planes;
+};
+
+// World space AABBs stored as centers and half extents in structure-of-arrays form, so that the
+// plane tests can work on several boxes per instruction.
+struct AabbList {
+  void Clear() noexcept;
+  void Push(const glm::vec3& center, const glm::vec3& extent);
+  size_t Size() const noexcept { return CenterX.size(); }
+
+  std::vector<float> CenterX;
+  std::vector<float> CenterY;
+  std::vector<float> CenterZ;
+  std::vector<float> ExtentX;
+  std::vector<float> ExtentY;
+  std::vector<float> ExtentZ;
+};
+
+Frustum ExtractFrustum(const glm::mat4& viewProj);
+// Computes the world space AABB enclosing a transformed local AABB.
+void TransformBounds(const BoundingBox& bounds, const glm::mat4& transform, glm::vec3& center,
+                     glm::vec3& extent);
+// Sets visible[i] to 1 for each box that intersects the frustum and 0 otherwise, returning the
+// number of visible boxes. Uses SSE when the target supports it.
+size_t CullAabbs(const Frustum& frustum, const AabbList& boxes, uint8_t* visible);
+// Plain scalar version of CullAabbs, kept as a reference for testing and benchmarking.
+size_t CullAabbsScalar(const Frustum& frustum, const AabbList& boxes, uint8_t* visible);
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "Core.h"
+
+#include "GpuProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Raven {
+constexpr static uint32_t gMaxPasses{16};
+constexpr static uint32_t gQueriesPerFrame{gMaxPasses * 2};
+
+GpuProfiler::GpuProfiler(vk::Device device, float timestampPeriod, uint32_t timestampValidBits,
+                         uint32_t frameCount, size_t historyFrames)
+    : mDevice(device),
+      mTimestampPeriod(timestampPeriod),
+      mSlotPasses(frameCount),
+      mHistoryFrames(std::max(historyFrames, size_t{1})) {
+  mTimings.resize(mHistoryFrames * gMaxPasses, std::numeric_limits<float>::quiet_NaN());
+  if (timestampValidBits == 0) {
+    Log::Warn("[GpuProfiler] The graphics queue does not support timestamps, profiling disabled.");
+    return;
+  }
+
+  mTimestampMask = timestampValidBits >= 64 ? ~0ull : (1ull << timestampValidBits) - 1;
+  const vk::QueryPoolCreateInfo poolCI({}, vk::QueryType::eTimestamp,
+                                       gQueriesPerFrame * frameCount);
+  mPool = mDevice.createQueryPoolUnique(poolCI);
+}
+
+void GpuProfiler::BeginFrame(vk::CommandBuffer cmd, uint32_t frameIndex) {
+  if (!mPool) {
+    return;
+  }
+
+  Resolve(frameIndex);
+  mCurrentSlot = frameIndex;
+  mSlotPasses[frameIndex].clear();
+  cmd.resetQueryPool(*mPool, frameIndex * gQueriesPerFrame, gQueriesPerFrame);
+
+  mFramePass = AddPass("Frame");
+  mFramePass.Begin(cmd);
+}
+
+void GpuProfiler::EndFrame(vk::CommandBuffer cmd) { mFramePass.End(cmd); }
+
+GpuPass GpuProfiler::AddPass(const std::string& name) {
+  std::vector<uint32_t>& passes{mSlotPasses[mCurrentSlot]};
+  if (!mPool || passes.size() >= gMaxPasses) {
+    return {};
+  }
+
+  uint32_t pass{0};
+  while (pass < mPassNames.size() && mPassNames[pass] != name) {
+    pass++;
+  }
+  if (pass == mPassNames.size()) {
+    if (pass >= gMaxPasses) {
+      return {};
+    }
+    mPassNames.push_back(name);
+  }
+
+  const uint32_t query{mCurrentSlot * gQueriesPerFrame + static_cast<uint32_t>(passes.size()) * 2};
+  passes.push_back(pass);
+
+  return GpuPass{*mPool, query};
+}
+
+std::vector<GpuPassStats> GpuProfiler::GetStats() const {
+  std::vector<GpuPassStats> stats;
+  std::vector<float> samples;
+  for (uint32_t pass = 0; pass < mPassNames.size(); pass++) {
+    samples.clear();
+    for (size_t row = 0; row < mHistoryRows; row++) {
+      const float ms{mTimings[row * gMaxPasses + pass]};
+      if (!std::isnan(ms)) {
+        samples.push_back(ms);
+      }
+    }
+    if (samples.empty()) {
+      continue;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    GpuPassStats& passStats{stats.emplace_back()};
+    passStats.Name = mPassNames[pass];
+    passStats.Samples = static_cast<uint32_t>(samples.size());
+    passStats.MinMs = samples.front();
+    passStats.MaxMs = samples.back();
+    for (const float ms : samples) {
+      passStats.AvgMs += ms;
+    }
+    passStats.AvgMs /= samples.size();
+    const size_t p99{static_cast<size_t>(std::ceil(samples.size() * 0.99)) - 1};
+    passStats.P99Ms = samples[std::min(p99, samples.size() - 1)];
+  }
+
+  return stats;
+}
+
+void GpuProfiler::ResetStats() {
+  std::fill(mTimings.begin(), mTimings.end(), std::numeric_limits<float>::quiet_NaN());
+  mHistoryRows = 0;
+  mNextRow = 0;
+}
+
+void GpuProfiler::LogStats() const {
+  for (const auto& pass : GetStats()) {
+    Log::Info("[GpuProfiler] {}: min {:.3f}ms, avg {:.3f}ms, p99 {:.3f}ms, max {:.3f}ms",
+              pass.Name, pass.MinMs, pass.AvgMs, pass.P99Ms, pass.MaxMs);
+  }
+}
+
+void GpuProfiler::Resolve(uint32_t frameIndex) {
+  const std::vector<uint32_t>& passes{mSlotPasses[frameIndex]};
+  if (passes.empty()) {
+    return;
+  }
+
+  const uint32_t queryCount{static_cast<uint32_t>(passes.size()) * 2};
+  std::array<uint64_t, gQueriesPerFrame> timestamps;
+  const vk::Result result{mDevice.getQueryPoolResults(
+      *mPool, frameIndex * gQueriesPerFrame, queryCount, queryCount * sizeof(uint64_t),
+      timestamps.data(), sizeof(uint64_t), vk::QueryResultFlagBits::e64)};
+  if (result != vk::Result::eSuccess) {
+    return;
+  }
+
+  float* row{&mTimings[mNextRow * gMaxPasses]};
+  std::fill(row, row + gMaxPasses, std::numeric_limits<float>::quiet_NaN());
+  for (size_t i = 0; i < passes.size(); i++) {
+    const uint64_t ticks{(timestamps[i * 2 + 1] - timestamps[i * 2]) & mTimestampMask};
+    const float ms{static_cast<float>(ticks) * mTimestampPeriod / 1000000.0f};
+    // A pass that runs more than once in a frame reports its total.
+    float& total{row[passes[i]]};
+    total = std::isnan(total) ? ms : total + ms;
+  }
+  mLastFrameMs = row[0];
+
+  mNextRow = (mNextRow + 1) % mHistoryFrames;
+  mHistoryRows = std::min(mHistoryRows + 1, mHistoryFrames);
+}
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "VulkanCore.h"
+
+namespace Raven {
+// A pair of timestamp queries around one pass. Begin and End may be recorded into different
+// command buffers of the same frame, and from any thread.
+struct GpuPass {
+  vk::QueryPool Pool;
+  uint32_t Query{0};
+
+  void Begin(vk::CommandBuffer cmd) const {
+    if (Pool) {
+      cmd.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, Pool, Query);
+    }
+  }
+  void End(vk::CommandBuffer cmd) const {
+    if (Pool) {
+      cmd.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, Pool, Query + 1);
+    }
+  }
+};
+
+struct GpuPassStats {
+  std::string Name;
+  uint32_t Samples{0};
+  float MinMs{0.0f};
+  float AvgMs{0.0f};
+  float P99Ms{0.0f};
+  float MaxMs{0.0f};
+};
+
+// Measures GPU time per pass with timestamp queries. Every frame in flight has its own block of
+// queries, which is read back the next time that frame begins. By then the frame has already been
+// waited on, so results arrive frames-in-flight late but never stall. Resolved times are kept in a
+// ring of recent frames, one column per pass.
+class GpuProfiler final {
+ public:
+  // A timestampValidBits of zero means the queue does not support timestamps, and every pass is
+  // ignored. Statistics cover the most recent historyFrames resolved frames.
+  GpuProfiler(vk::Device device, float timestampPeriod, uint32_t timestampValidBits,
+              uint32_t frameCount, size_t historyFrames = 512);
+  GpuProfiler(const GpuProfiler&) = delete;
+
+  // Resolves the queries written the last time this frame slot was used, then resets them and
+  // begins the whole-frame pass. The slot's previous submission must have completed.
+  void BeginFrame(vk::CommandBuffer cmd, uint32_t frameIndex);
+  void EndFrame(vk::CommandBuffer cmd);
+  // Reserves a pass in the current frame. Must be called on the thread that calls BeginFrame.
+  GpuPass AddPass(const std::string& name);
+
+  std::vector<GpuPassStats> GetStats() const;
+  // Discards every resolved frame, so statistics start over from the next one.
+  void ResetStats();
+  // Whole-frame GPU time of the most recently resolved frame.
+  float LastFrameMs() const noexcept { return mLastFrameMs; }
+  void LogStats() const;
+
+  bool Enabled() const noexcept { return static_cast<bool>(mPool); }
+
+ private:
+  void Resolve(uint32_t frameIndex);
+
+  vk::Device mDevice;
+  vk::UniqueQueryPool mPool;
+  float mTimestampPeriod;
+  uint64_t mTimestampMask{0};
+
+  // The pass of every query pair written by each frame slot, in query order.
+  std::vector<std::vector<uint32_t>> mSlotPasses;
+  uint32_t mCurrentSlot{0};
+  GpuPass mFramePass;
+
+  std::vector<std::string> mPassNames;
+  // Passes that did not run in a frame are left as NaN.
+  std::vector<float> mTimings;
+  size_t mHistoryFrames;
+  size_t mHistoryRows{0};
+  size_t mNextRow{0};
+  float mLastFrameMs{0.0f};
+};
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "Core.h"
+
+#include "JobSystem.h"
+
+namespace Raven {
+// Index of the worker running on this thread, used to push nested jobs onto the worker's own queue.
+static thread_local uint32_t gWorkerIndex{std::numeric_limits<uint32_t>::max()};
+static thread_local const JobSystem* gWorkerOwner{nullptr};
+
+JobSystem::JobSystem(uint32_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+  }
+
+  for (uint32_t i = 0; i < threadCount; i++) {
+    mQueues.push_back(std::make_unique<WorkQueue>());
+  }
+  for (uint32_t i = 0; i < threadCount; i++) {
+    mWorkers.emplace_back(&JobSystem::WorkerMain, this, i);
+  }
+
+  Log::Debug("[JobSystem] Started {} worker threads.", threadCount);
+}
+
+JobSystem::~JobSystem() {
+  WaitIdle();
+
+  {
+    std::lock_guard<std::mutex> lock(mWakeMutex);
+    mRunning = false;
+  }
+  mWakeCondition.notify_all();
+  for (auto& worker : mWorkers) {
+    worker.join();
+  }
+}
+
+void JobSystem::Submit(Job job) {
+  const uint32_t queueIndex{gWorkerOwner == this
+                                ? gWorkerIndex
+                                : mNextQueue.fetch_add(1) % static_cast<uint32_t>(mQueues.size())};
+  mPendingJobs++;
+  {
+    WorkQueue& queue{*mQueues[queueIndex]};
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    queue.Jobs.push_back(std::move(job));
+    mQueuedJobs++;
+  }
+
+  // The wake mutex orders this notify against a worker that has just found every queue empty and
+  // is about to sleep.
+  std::lock_guard<std::mutex> lock(mWakeMutex);
+  mWakeCondition.notify_one();
+}
+
+void JobSystem::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& fn) {
+  if (count == 0) {
+    return;
+  }
+
+  // Indices are claimed from a shared counter rather than handed out up front, so a busy worker
+  // never holds up the loop; the calling thread simply claims more. A helper that starts after
+  // every index has been claimed returns without touching fn, which may no longer exist by then.
+  struct Loop {
+    const std::function<void(uint32_t)>* Fn{nullptr};
+    uint32_t Count{0};
+    std::atomic<uint32_t> Next{0};
+    std::atomic<uint32_t> Finished{0};
+    std::mutex Mutex;
+    std::condition_variable Done;
+  };
+  auto loop{std::make_shared<Loop>()};
+  loop->Fn = &fn;
+  loop->Count = count;
+
+  const auto run{[](Loop& loop) {
+    uint32_t index;
+    while ((index = loop.Next++) < loop.Count) {
+      (*loop.Fn)(index);
+      if (++loop.Finished == loop.Count) {
+        std::lock_guard<std::mutex> lock(loop.Mutex);
+        loop.Done.notify_all();
+      }
+    }
+  }};
+
+  const uint32_t helpers{std::min(count, WorkerCount() + 1) - 1};
+  for (uint32_t i = 0; i < helpers; i++) {
+    Submit([loop, run]() { run(*loop); });
+  }
+  run(*loop);
+
+  std::unique_lock<std::mutex> lock(loop->Mutex);
+  loop->Done.wait(lock, [&loop]() { return loop->Finished == loop->Count; });
+}
+
+void JobSystem::WaitIdle() {
+  std::unique_lock<std::mutex> lock(mWakeMutex);
+  mIdleCondition.wait(lock, [this]() { return mPendingJobs == 0; });
+}
+
+void JobSystem::WorkerMain(uint32_t index) {
+  gWorkerIndex = index;
+  gWorkerOwner = this;
+  Profiler::SetThreadName(fmt::format("Worker {}", index));
+
+  Job job;
+  while (true) {
+    if (PopJob(index, job)) {
+      job();
+      job = nullptr;
+
+      if (--mPendingJobs == 0) {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mIdleCondition.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mWakeMutex);
+    mWakeCondition.wait(lock, [this]() { return !mRunning || mQueuedJobs > 0; });
+    if (!mRunning) {
+      break;
+    }
+  }
+}
+
+bool JobSystem::PopJob(uint32_t index, Job& job) {
+  // Own queue first, newest job first, as its data is most likely still in cache.
+  {
+    WorkQueue& queue{*mQueues[index]};
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Jobs.empty()) {
+      job = std::move(queue.Jobs.back());
+      queue.Jobs.pop_back();
+      mQueuedJobs--;
+      return true;
+    }
+  }
+
+  // Steal the oldest job from another worker.
+  const uint32_t queueCount{static_cast<uint32_t>(mQueues.size())};
+  for (uint32_t i = 1; i < queueCount; i++) {
+    WorkQueue& queue{*mQueues[(index + i) % queueCount]};
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Jobs.empty()) {
+      job = std::move(queue.Jobs.front());
+      queue.Jobs.pop_front();
+      mQueuedJobs--;
+      return true;
+    }
+  }
+
+  return false;
+}
+}  // namespace Raven
\ No newline at end of file
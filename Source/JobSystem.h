@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Raven {
+// A fixed pool of worker threads. Every worker owns a deque of jobs: it pushes and pops its own
+// jobs at the back, and when it runs dry it steals from the front of the other workers' deques.
+// Jobs submitted from outside the pool are spread across the deques round-robin.
+class JobSystem final {
+ public:
+  using Job = std::function<void()>;
+
+  // A thread count of zero uses one worker per hardware thread, minus one for the main thread, and
+  // never fewer than one.
+  explicit JobSystem(uint32_t threadCount = 0);
+  JobSystem(const JobSystem&) = delete;
+  ~JobSystem();
+
+  void Submit(Job job);
+  // Calls fn once for every index in [0, count), spread across the workers and the calling thread.
+  // Returns once every call has finished, without waiting on unrelated jobs.
+  void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& fn);
+  // Blocks until every submitted job has finished.
+  void WaitIdle();
+
+  uint32_t WorkerCount() const noexcept { return static_cast<uint32_t>(mWorkers.size()); }
+
+ private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<Job> Jobs;
+  };
+
+  void WorkerMain(uint32_t index);
+  bool PopJob(uint32_t index, Job& job);
+
+  std::vector<std::unique_ptr<WorkQueue>> mQueues;
+  std::vector<std::thread> mWorkers;
+  std::atomic<uint32_t> mNextQueue{0};
+  // Jobs that have been submitted but not yet finished, and those not yet picked up by a worker.
+  std::atomic<uint32_t> mPendingJobs{0};
+  std::atomic<uint32_t> mQueuedJobs{0};
+  std::atomic<bool> mRunning{true};
+
+  std::mutex mWakeMutex;
+  std::condition_variable mWakeCondition;
+  std::condition_variable mIdleCondition;
+};
+}  // namespace Raven
\ No newline at end of file
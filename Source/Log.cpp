@@ -2,12 +2,15 @@
 
 #include <fmt/chrono.h>
 #include <fmt/color.h>
+#include <mutex>
 
 #include "Log.h"
 #include "Win32.h"
 
 namespace Raven {
 Log::Level Log::sLogLevel{Level::Info};
+// Messages can come from worker threads, and must not interleave.
+static std::mutex gOutputMutex;
 constexpr const char* gLevelTags[]{"FTL", "ERR", "WRN", "INF", "DBG", "TRC"};
 const fmt::v7::text_style gLevelColors[]{
     fmt::v7::fg(fmt::color::black) | fmt::v7::bg(fmt::color::red),  // Fatal
@@ -19,6 +22,7 @@ const fmt::v7::text_style gLevelColors[]{
 };
 
 void Log::Initialize() noexcept {
+#ifdef _WIN32
   ::AllocConsole();
   ::AttachConsole(::GetCurrentProcessId());
 
@@ -39,9 +43,14 @@ void Log::Initialize() noexcept {
   freopen_s(&stream, "CONOUT$", "w+", stdout);
   freopen_s(&stream, "CONOUT$", "w+", stderr);
   ::SetConsoleTitle(TEXT("Raven Console"));
+#endif
 }
 
-void Log::Shutdown() noexcept { ::FreeConsole(); }
+void Log::Shutdown() noexcept {
+#ifdef _WIN32
+  ::FreeConsole();
+#endif
+}
 
 void Log::SetLevel(const Level level) noexcept { sLogLevel = level; }
 
@@ -49,7 +58,10 @@ void Log::Output(const Level level, const std::string& msg) noexcept {
   const std::chrono::time_point now{std::chrono::system_clock::now()};
   const std::string finalMsg{
       fmt::format("<{:%H:%M:%S}> [{}] {}\n", now, gLevelTags[static_cast<size_t>(level)], msg)};
+  std::lock_guard<std::mutex> lock(gOutputMutex);
   fmt::print(gLevelColors[static_cast<size_t>(level)], finalMsg);
+#ifdef _WIN32
   ::OutputDebugStringA(finalMsg.c_str());
+#endif
 }
 }  // namespace Raven
\ No newline at end of file
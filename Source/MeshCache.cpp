@@ -0,0 +1,264 @@
+#include "Core.h"
+
+#include "MeshCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Raven {
+constexpr static uint64_t gStreamAlignment{16};
+// Numbers temporary files, so concurrent writes of the same cache never share one.
+static std::atomic<uint32_t> gTempFileCounter{0};
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/* ==========================================================================================
+ * MappedFile
+ * ========================================================================================== */
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+  mFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (mFile == INVALID_HANDLE_VALUE) {
+    mFile = nullptr;
+    return;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0) {
+    Close();
+    return;
+  }
+
+  mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mMapping == nullptr) {
+    Close();
+    return;
+  }
+
+  mData = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+  if (mData == nullptr) {
+    Close();
+    return;
+  }
+  mSize = static_cast<size_t>(size.QuadPart);
+#else
+  const int fd{open(path.c_str(), O_RDONLY)};
+  if (fd < 0) {
+    return;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* data{mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0)};
+    if (data != MAP_FAILED) {
+      // The whole file is about to be read front to back.
+      madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL | MADV_WILLNEED);
+      mData = data;
+      mSize = static_cast<size_t>(st.st_size);
+    }
+  }
+
+  // The mapping keeps the file alive on its own.
+  close(fd);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& o) noexcept { *this = std::move(o); }
+
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept {
+  if (this != &o) {
+    Close();
+
+    mData = o.mData;
+    mSize = o.mSize;
+    o.mData = nullptr;
+    o.mSize = 0;
+#ifdef _WIN32
+    mFile = o.mFile;
+    mMapping = o.mMapping;
+    o.mFile = nullptr;
+    o.mMapping = nullptr;
+#endif
+  }
+
+  return *this;
+}
+
+MappedFile::~MappedFile() { Close(); }
+
+void MappedFile::Close() noexcept {
+#ifdef _WIN32
+  if (mData) {
+    UnmapViewOfFile(mData);
+  }
+  if (mMapping) {
+    CloseHandle(mMapping);
+  }
+  if (mFile) {
+    CloseHandle(mFile);
+  }
+  mMapping = nullptr;
+  mFile = nullptr;
+#else
+  if (mData) {
+    munmap(const_cast<void*>(mData), mSize);
+  }
+#endif
+  mData = nullptr;
+  mSize = 0;
+}
+
+/* ==========================================================================================
+ * Mesh Cache
+ * ========================================================================================== */
+
+bool ReadMeshCache(const MappedFile& file, uint64_t sourceHash, uint32_t vertexStride,
+                   MeshCacheView& view) {
+  if (!file || file.Size() < sizeof(MeshCacheHeader)) {
+    return false;
+  }
+
+  const MeshCacheHeader* header{static_cast<const MeshCacheHeader*>(file.Data())};
+  if (header->Magic != MeshCacheMagic || header->Version != MeshCacheVersion ||
+      header->SourceHash != sourceHash || header->VertexStride != vertexStride ||
+      (header->IndexSize != 2 && header->IndexSize != 4)) {
+    return false;
+  }
+
+  if (header->IndexCount % 3 != 0) {
+    Log::Warn("[ReadMeshCache] Mesh cache has a partial triangle.");
+    return false;
+  }
+
+  // Both counts and offsets come from the file, so every range is checked without overflowing.
+  const uint64_t size{file.Size()};
+  const uint64_t vertexBytes{uint64_t(header->VertexCount) * header->VertexStride};
+  const uint64_t indexBytes{uint64_t(header->IndexCount) * header->IndexSize};
+  const auto validStream{[size](uint64_t offset, uint64_t bytes) {
+    return offset >= sizeof(MeshCacheHeader) && offset % gStreamAlignment == 0 && offset <= size &&
+           bytes <= size - offset;
+  }};
+  if (!validStream(header->VertexOffset, vertexBytes) ||
+      !validStream(header->IndexOffset, indexBytes)) {
+    Log::Warn("[ReadMeshCache] Mesh cache is truncated.");
+    return false;
+  }
+
+  // Indices go straight to the GPU, so one past the vertex buffer would be an out-of-bounds read.
+  const uint8_t* bytes{static_cast<const uint8_t*>(file.Data())};
+  const void* indices{bytes + header->IndexOffset};
+  uint32_t maxIndex{0};
+  if (header->IndexSize == 2) {
+    const uint16_t* indices16{static_cast<const uint16_t*>(indices)};
+    for (uint32_t i = 0; i < header->IndexCount; i++) {
+      maxIndex = std::max<uint32_t>(maxIndex, indices16[i]);
+    }
+  } else {
+    const uint32_t* indices32{static_cast<const uint32_t*>(indices)};
+    for (uint32_t i = 0; i < header->IndexCount; i++) {
+      maxIndex = std::max(maxIndex, indices32[i]);
+    }
+  }
+  if (header->IndexCount > 0 && maxIndex >= header->VertexCount) {
+    Log::Warn("[ReadMeshCache] Mesh cache references vertex {} of {}.", maxIndex,
+              header->VertexCount);
+    return false;
+  }
+
+  view.Header = header;
+  view.Vertices = bytes + header->VertexOffset;
+  view.Indices = indices;
+
+  return true;
+}
+
+bool WriteMeshCache(const std::string& path, MeshCacheHeader header, const void* vertices,
+                    const void* indices) {
+  const uint64_t vertexBytes{uint64_t(header.VertexCount) * header.VertexStride};
+  const uint64_t indexBytes{uint64_t(header.IndexCount) * header.IndexSize};
+  header.VertexOffset = AlignUp(sizeof(MeshCacheHeader), gStreamAlignment);
+  header.IndexOffset = AlignUp(header.VertexOffset + vertexBytes, gStreamAlignment);
+
+  // Write to a temporary file first, so a crash mid-write never leaves a valid-looking cache. Two
+  // workers may cook the same mesh at once, so each writes its own file and the last rename wins.
+  const std::string tempPath{fmt::format("{}.{:x}.{}.tmp", path,
+                                         std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                                         gTempFileCounter++)};
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+
+    const char padding[gStreamAlignment]{};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding, header.VertexOffset - sizeof(header));
+    file.write(static_cast<const char*>(vertices), vertexBytes);
+    file.write(padding, header.IndexOffset - (header.VertexOffset + vertexBytes));
+    file.write(static_cast<const char*>(indices), indexBytes);
+    if (!file) {
+      file.close();
+      std::remove(tempPath.c_str());
+      return false;
+    }
+  }
+
+  std::remove(path.c_str());
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+uint64_t HashData(const void* data, size_t size, uint64_t seed) {
+  // FNV-1a, consuming 8 bytes per step.
+  constexpr uint64_t prime{1099511628211ull};
+  const uint8_t* bytes{static_cast<const uint8_t*>(data)};
+  uint64_t hash{seed};
+
+  size_t i{0};
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * prime;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ bytes[i]) * prime;
+  }
+
+  // Whole words leave their high bits poorly mixed into the low bits of the hash, so finish with
+  // the murmur3 fmix64 avalanche.
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDull;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ull;
+  hash ^= hash >> 33;
+
+  return hash;
+}
+
+uint64_t HashFile(const std::string& path, uint64_t seed) {
+  const MappedFile file(path);
+  if (!file) {
+    return seed;
+  }
+
+  return HashData(file.Data(), file.Size(), HashData(&seed, sizeof(seed)));
+}
+}  // namespace Raven
\ No newline at end of file
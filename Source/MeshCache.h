@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MeshProcessing.h"
+
+namespace Raven {
+// Read-only memory mapping of an entire file.
+class MappedFile final {
+ public:
+  MappedFile() = default;
+  explicit MappedFile(const std::string& path);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&& o) noexcept;
+  MappedFile& operator=(MappedFile&& o) noexcept;
+  ~MappedFile();
+
+  const void* Data() const noexcept { return mData; }
+  size_t Size() const noexcept { return mSize; }
+  explicit operator bool() const noexcept { return mData != nullptr; }
+
+ private:
+  void Close() noexcept;
+
+  const void* mData{nullptr};
+  size_t mSize{0};
+#ifdef _WIN32
+  void* mFile{nullptr};
+  void* mMapping{nullptr};
+#endif
+};
+
+// .rvmesh files hold a mesh exactly as it is laid out on the GPU, so loading one is a single copy
+// from the mapped file into the staging ring.
+constexpr uint32_t MeshCacheMagic{0x53454D52};  // "RMES"
+constexpr uint32_t MeshCacheVersion{1};
+
+struct MeshCacheHeader {
+  uint32_t Magic{MeshCacheMagic};
+  uint32_t Version{MeshCacheVersion};
+  uint64_t SourceHash{0};
+  uint32_t VertexCount{0};
+  uint32_t VertexStride{0};
+  uint32_t IndexCount{0};
+  uint32_t IndexSize{0};
+  BoundingBox Bounds;
+  uint64_t VertexOffset{0};
+  uint64_t IndexOffset{0};
+};
+
+struct MeshCacheView {
+  const MeshCacheHeader* Header{nullptr};
+  const void* Vertices{nullptr};
+  const void* Indices{nullptr};
+};
+
+// Validates a mapped cache file against the expected source hash and vertex layout. Returns false
+// if the file is stale or malformed, in which case it should be cooked again.
+bool ReadMeshCache(const MappedFile& file, uint64_t sourceHash, uint32_t vertexStride,
+                   MeshCacheView& view);
+// Writes a cache file. The stream offsets of the header are filled in here.
+bool WriteMeshCache(const std::string& path, MeshCacheHeader header, const void* vertices,
+                    const void* indices);
+
+uint64_t HashData(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+// Hashes the contents of a file, or returns seed unchanged if the file does not exist.
+uint64_t HashFile(const std::string& path, uint64_t seed = 14695981039346656037ull);
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,404 @@
+#include "Core.h"
+
+#include "MeshProcessing.h"
+
+#include <algorithm>
+
+namespace Raven {
+static uint64_t HashBytes(const void* data, size_t size) {
+  // FNV-1a
+  const uint8_t* bytes{static_cast<const uint8_t*>(data)};
+  uint64_t hash{14695981039346656037ull};
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+size_t GenerateVertexRemap(std::vector<uint32_t>& remap, const void* vertices, size_t vertexCount,
+                           size_t vertexSize) {
+  constexpr uint32_t empty{std::numeric_limits<uint32_t>::max()};
+  const uint8_t* data{static_cast<const uint8_t*>(vertices)};
+
+  remap.assign(vertexCount, empty);
+
+  // Open addressing table of original vertex indices, sized to a power of two at least twice the
+  // vertex count so probe chains stay short.
+  size_t tableSize{1};
+  while (tableSize < vertexCount * 2) {
+    tableSize *= 2;
+  }
+  std::vector<uint32_t> table(tableSize, empty);
+
+  uint32_t uniqueCount{0};
+  for (size_t i = 0; i < vertexCount; i++) {
+    const uint8_t* vertex{data + i * vertexSize};
+    size_t slot{HashBytes(vertex, vertexSize) & (tableSize - 1)};
+
+    while (table[slot] != empty &&
+           memcmp(data + table[slot] * vertexSize, vertex, vertexSize) != 0) {
+      slot = (slot + 1) & (tableSize - 1);
+    }
+
+    if (table[slot] == empty) {
+      table[slot] = static_cast<uint32_t>(i);
+      remap[i] = uniqueCount++;
+    } else {
+      remap[i] = remap[table[slot]];
+    }
+  }
+
+  return uniqueCount;
+}
+
+void RemapVertexBuffer(void* dst, const void* src, size_t vertexCount, size_t vertexSize,
+                       const std::vector<uint32_t>& remap) {
+  uint8_t* dstBytes{static_cast<uint8_t*>(dst)};
+  const uint8_t* srcBytes{static_cast<const uint8_t*>(src)};
+  for (size_t i = 0; i < vertexCount; i++) {
+    if (remap[i] != std::numeric_limits<uint32_t>::max()) {
+      memcpy(dstBytes + remap[i] * vertexSize, srcBytes + i * vertexSize, vertexSize);
+    }
+  }
+}
+
+void RemapIndexBuffer(uint32_t* indices, size_t indexCount, const std::vector<uint32_t>& remap) {
+  for (size_t i = 0; i < indexCount; i++) {
+    indices[i] = remap[indices[i]];
+  }
+}
+
+BoundingBox ComputeBounds(const float* positions, size_t positionStride, size_t vertexCount) {
+  BoundingBox bounds;
+  if (vertexCount == 0) {
+    return bounds;
+  }
+
+  const uint8_t* bytes{reinterpret_cast<const uint8_t*>(positions)};
+  bounds.Min = glm::vec3(std::numeric_limits<float>::max());
+  bounds.Max = glm::vec3(std::numeric_limits<float>::lowest());
+  for (size_t i = 0; i < vertexCount; i++) {
+    const float* p{reinterpret_cast<const float*>(bytes + i * positionStride)};
+    const glm::vec3 position(p[0], p[1], p[2]);
+    bounds.Min = glm::min(bounds.Min, position);
+    bounds.Max = glm::max(bounds.Max, position);
+  }
+
+  return bounds;
+}
+
+void PackIndices(void* dst, const uint32_t* indices, size_t indexCount, uint32_t indexSize) {
+  if (indexSize == sizeof(uint32_t)) {
+    memcpy(dst, indices, indexCount * sizeof(uint32_t));
+    return;
+  }
+
+  uint16_t* dst16{static_cast<uint16_t*>(dst)};
+  for (size_t i = 0; i < indexCount; i++) {
+    dst16[i] = static_cast<uint16_t>(indices[i]);
+  }
+}
+
+/* ==========================================================================================
+ * Vertex Cache
+ * ========================================================================================== */
+
+// Simulates a FIFO post-transform cache. Vertices are tagged with the timestamp at which they
+// entered the cache, so a vertex is resident while fewer than cacheSize misses have happened since.
+class FifoCache {
+ public:
+  FifoCache(size_t vertexCount, uint32_t cacheSize)
+      : mCacheSize(cacheSize), mTimestamps(vertexCount, 0), mTime(cacheSize + 1) {}
+
+  bool Contains(uint32_t vertex) const { return mTime - mTimestamps[vertex] <= mCacheSize; }
+  // Returns true on a cache miss.
+  bool Access(uint32_t vertex) {
+    if (Contains(vertex)) {
+      return false;
+    }
+    mTimestamps[vertex] = mTime++;
+
+    return true;
+  }
+  // Empties the cache in constant time by moving the clock past every resident timestamp.
+  void Reset() { mTime += mCacheSize + 1; }
+
+ private:
+  uint32_t mCacheSize;
+  std::vector<uint32_t> mTimestamps;
+  uint32_t mTime;
+};
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                    uint32_t cacheSize) {
+  VertexCacheStats stats;
+  if (indexCount == 0) {
+    return stats;
+  }
+
+  FifoCache cache(vertexCount, cacheSize);
+  std::vector<bool> referenced(vertexCount, false);
+  size_t uniqueCount{0};
+  for (size_t i = 0; i < indexCount; i++) {
+    if (cache.Access(indices[i])) {
+      stats.VerticesTransformed++;
+    }
+    if (!referenced[indices[i]]) {
+      referenced[indices[i]] = true;
+      uniqueCount++;
+    }
+  }
+
+  stats.ACMR = static_cast<float>(stats.VerticesTransformed) / (indexCount / 3);
+  stats.ATVR = static_cast<float>(stats.VerticesTransformed) / uniqueCount;
+
+  return stats;
+}
+
+// Vertex to triangle adjacency, stored as a flat list with per-vertex offsets.
+struct TriangleAdjacency {
+  TriangleAdjacency(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+      : Offsets(vertexCount + 1, 0), Triangles(indexCount) {
+    for (size_t i = 0; i < indexCount; i++) {
+      Offsets[indices[i] + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; v++) {
+      Offsets[v + 1] += Offsets[v];
+    }
+    std::vector<uint32_t> fill(Offsets.begin(), Offsets.end() - 1);
+    for (size_t i = 0; i < indexCount; i++) {
+      Triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+  }
+
+  uint32_t Count(uint32_t vertex) const { return Offsets[vertex + 1] - Offsets[vertex]; }
+
+  std::vector<uint32_t> Offsets;
+  std::vector<uint32_t> Triangles;
+};
+
+void OptimizeVertexCache(uint32_t* dst, const uint32_t* indices, size_t indexCount,
+                         size_t vertexCount, uint32_t cacheSize) {
+  if (indexCount == 0) {
+    return;
+  }
+
+  constexpr uint32_t none{std::numeric_limits<uint32_t>::max()};
+  const TriangleAdjacency adjacency(indices, indexCount, vertexCount);
+
+  std::vector<uint32_t> liveTriangles(vertexCount);
+  for (uint32_t v = 0; v < vertexCount; v++) {
+    liveTriangles[v] = adjacency.Count(v);
+  }
+
+  std::vector<bool> emitted(indexCount / 3, false);
+  std::vector<uint32_t> cacheTime(vertexCount, 0);
+  uint32_t timestamp{cacheSize + 1};
+  std::vector<uint32_t> deadEnd;
+  deadEnd.reserve(indexCount);
+  std::vector<uint32_t> candidates;
+  uint32_t cursor{0};
+  size_t written{0};
+
+  // Start fanning from the first vertex that is actually referenced.
+  uint32_t fan{none};
+  while (cursor < vertexCount && fan == none) {
+    if (liveTriangles[cursor] > 0) {
+      fan = cursor;
+    }
+    cursor++;
+  }
+
+  while (fan != none) {
+    candidates.clear();
+
+    // Emit every remaining triangle around the fanning vertex.
+    for (uint32_t i = adjacency.Offsets[fan]; i < adjacency.Offsets[fan + 1]; i++) {
+      const uint32_t triangle{adjacency.Triangles[i]};
+      if (emitted[triangle]) {
+        continue;
+      }
+      emitted[triangle] = true;
+
+      for (uint32_t corner = 0; corner < 3; corner++) {
+        const uint32_t v{indices[triangle * 3 + corner]};
+        dst[written++] = v;
+        deadEnd.push_back(v);
+        candidates.push_back(v);
+        liveTriangles[v]--;
+        if (timestamp - cacheTime[v] > cacheSize) {
+          cacheTime[v] = timestamp++;
+        }
+      }
+    }
+
+    // Pick the candidate that will still be in the cache once its remaining triangles are emitted,
+    // preferring the one that entered the cache earliest.
+    uint32_t next{none};
+    uint32_t bestPriority{0};
+    for (const uint32_t v : candidates) {
+      if (liveTriangles[v] == 0) {
+        continue;
+      }
+      uint32_t priority{0};
+      if (timestamp - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize) {
+        priority = timestamp - cacheTime[v];
+      }
+      if (next == none || priority > bestPriority) {
+        bestPriority = priority;
+        next = v;
+      }
+    }
+
+    // Dead end: fall back to recently emitted vertices, then to the next unprocessed vertex.
+    while (next == none && !deadEnd.empty()) {
+      const uint32_t v{deadEnd.back()};
+      deadEnd.pop_back();
+      if (liveTriangles[v] > 0) {
+        next = v;
+      }
+    }
+    while (next == none && cursor < vertexCount) {
+      if (liveTriangles[cursor] > 0) {
+        next = cursor;
+      }
+      cursor++;
+    }
+
+    fan = next;
+  }
+}
+
+/* ==========================================================================================
+ * Overdraw
+ * ========================================================================================== */
+
+void OptimizeOverdraw(uint32_t* dst, const uint32_t* indices, size_t indexCount,
+                      const float* positions, size_t positionStride, size_t vertexCount,
+                      float threshold, uint32_t cacheSize) {
+  const size_t triangleCount{indexCount / 3};
+  if (triangleCount == 0) {
+    return;
+  }
+
+  const auto position{[positions, positionStride](uint32_t v) {
+    const float* p{reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) +
+                                                  v * positionStride)};
+    return glm::vec3(p[0], p[1], p[2]);
+  }};
+
+  // Hard boundaries are where every vertex of a triangle misses the cache. Reordering clusters at
+  // these points costs nothing, since the cache is effectively cold there anyway. The misses of
+  // each hard cluster are counted along the way to give its ACMR.
+  FifoCache cache(vertexCount, cacheSize);
+  std::vector<uint32_t> hardClusters;
+  std::vector<uint32_t> hardMisses;
+  for (size_t t = 0; t < triangleCount; t++) {
+    uint32_t misses{0};
+    for (uint32_t corner = 0; corner < 3; corner++) {
+      misses += cache.Access(indices[t * 3 + corner]) ? 1 : 0;
+    }
+    if (t == 0 || misses == 3) {
+      hardClusters.push_back(static_cast<uint32_t>(t));
+      hardMisses.push_back(0);
+    }
+    hardMisses.back() += misses;
+  }
+  hardClusters.push_back(static_cast<uint32_t>(triangleCount));
+
+  // Soft boundaries split hard clusters further, wherever the running ACMR of the current cluster
+  // is already no worse than the hard cluster's ACMR scaled by threshold.
+  std::vector<uint32_t> clusters;
+  for (size_t c = 0; c + 1 < hardClusters.size(); c++) {
+    const uint32_t start{hardClusters[c]};
+    const uint32_t end{hardClusters[c + 1]};
+    const float limit{static_cast<float>(hardMisses[c]) / (end - start) * threshold};
+
+    cache.Reset();
+    uint32_t clusterStart{start};
+    uint32_t clusterMisses{0};
+    clusters.push_back(start);
+    for (uint32_t t = start; t < end; t++) {
+      for (uint32_t corner = 0; corner < 3; corner++) {
+        clusterMisses += cache.Access(indices[t * 3 + corner]) ? 1 : 0;
+      }
+      const uint32_t clusterTriangles{t + 1 - clusterStart};
+      if (t + 1 < end && static_cast<float>(clusterMisses) / clusterTriangles <= limit) {
+        clusters.push_back(t + 1);
+        clusterStart = t + 1;
+        clusterMisses = 0;
+        cache.Reset();
+      }
+    }
+  }
+  clusters.push_back(static_cast<uint32_t>(triangleCount));
+
+  glm::vec3 meshCentroid{0.0f};
+  for (size_t i = 0; i < indexCount; i++) {
+    meshCentroid += position(indices[i]);
+  }
+  meshCentroid /= static_cast<float>(indexCount);
+
+  // Clusters whose area-weighted normal points away from the mesh center are likely to occlude
+  // the rest of the mesh, so they are sorted to draw first.
+  const size_t clusterCount{clusters.size() - 1};
+  std::vector<float> sortKeys(clusterCount);
+  for (size_t c = 0; c < clusterCount; c++) {
+    glm::vec3 centroid{0.0f};
+    glm::vec3 normal{0.0f};
+    float area{0.0f};
+    for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++) {
+      const glm::vec3 p0{position(indices[t * 3 + 0])};
+      const glm::vec3 p1{position(indices[t * 3 + 1])};
+      const glm::vec3 p2{position(indices[t * 3 + 2])};
+      const glm::vec3 n{glm::cross(p1 - p0, p2 - p0)};
+      const float triangleArea{glm::length(n)};
+
+      centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+      normal += n;
+      area += triangleArea;
+    }
+    centroid = area > 0.0f ? centroid / area : position(indices[clusters[c] * 3]);
+    const float normalLength{glm::length(normal)};
+    normal = normalLength > 0.0f ? normal / normalLength : glm::vec3(0.0f);
+
+    sortKeys[c] = glm::dot(centroid - meshCentroid, normal);
+  }
+
+  std::vector<uint32_t> order(clusterCount);
+  for (uint32_t c = 0; c < clusterCount; c++) {
+    order[c] = c;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&sortKeys](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+  size_t written{0};
+  for (const uint32_t c : order) {
+    const size_t start{clusters[c] * size_t(3)};
+    const size_t count{(clusters[c + 1] - clusters[c]) * size_t(3)};
+    memcpy(dst + written, indices + start, count * sizeof(uint32_t));
+    written += count;
+  }
+}
+
+/* ==========================================================================================
+ * Vertex Fetch
+ * ========================================================================================== */
+
+size_t GenerateVertexFetchRemap(std::vector<uint32_t>& remap, const uint32_t* indices,
+                                size_t indexCount, size_t vertexCount) {
+  constexpr uint32_t unused{std::numeric_limits<uint32_t>::max()};
+  remap.assign(vertexCount, unused);
+
+  uint32_t next{0};
+  for (size_t i = 0; i < indexCount; i++) {
+    if (remap[indices[i]] == unused) {
+      remap[indices[i]] = next++;
+    }
+  }
+
+  return next;
+}
+}  // namespace Raven
\ No newline at end of file
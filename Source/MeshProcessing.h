@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+// CPU-side mesh processing. Nothing in here touches Vulkan, so it can run on any thread and be
+// exercised without a GPU.
+namespace Raven {
+// Builds a remap table that collapses bitwise-identical vertices. remap[i] is the new index of
+// vertex i. Returns the number of unique vertices.
+size_t GenerateVertexRemap(std::vector<uint32_t>& remap, const void* vertices, size_t vertexCount,
+                           size_t vertexSize);
+// Writes the vertices of src to their remapped locations in dst. dst must have room for the unique
+// vertex count returned by GenerateVertexRemap. Vertices remapped to ~0u are dropped.
+void RemapVertexBuffer(void* dst, const void* src, size_t vertexCount, size_t vertexSize,
+                       const std::vector<uint32_t>& remap);
+void RemapIndexBuffer(uint32_t* indices, size_t indexCount, const std::vector<uint32_t>& remap);
+
+struct BoundingBox {
+  glm::vec3 Min{0.0f};
+  glm::vec3 Max{0.0f};
+};
+
+BoundingBox ComputeBounds(const float* positions, size_t positionStride, size_t vertexCount);
+
+// Index buffers use 16-bit indices whenever every vertex can be addressed by one, halving index
+// bandwidth. Returns the index size in bytes.
+inline uint32_t GetIndexSize(size_t vertexCount) { return vertexCount <= 0xFFFF ? 2 : 4; }
+// Narrows 32-bit indices to indexSize bytes each.
+void PackIndices(void* dst, const uint32_t* indices, size_t indexCount, uint32_t indexSize);
+
+// Post-transform cache statistics from simulating a FIFO cache of the given size.
+// ACMR is vertex shader invocations per triangle (0.5 is ideal for large grids, 3 is worst case).
+// ATVR is invocations per unique vertex (1 is ideal).
+struct VertexCacheStats {
+  uint32_t VerticesTransformed{0};
+  float ACMR{0.0f};
+  float ATVR{0.0f};
+};
+
+constexpr uint32_t DefaultVertexCacheSize{16};
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                    uint32_t cacheSize = DefaultVertexCacheSize);
+// Reorders triangles for post-transform cache locality using Tipsify (Sander et al. 2007).
+// dst may not alias indices.
+void OptimizeVertexCache(uint32_t* dst, const uint32_t* indices, size_t indexCount,
+                         size_t vertexCount, uint32_t cacheSize = DefaultVertexCacheSize);
+// Reorders clusters of an already cache-optimized index buffer so that triangles facing outwards
+// from the mesh center are drawn first, reducing overdraw. Clusters are split wherever the cache
+// would be flushed, and further split while their ACMR stays within threshold of the original, so
+// cache efficiency degrades by at most that factor. dst may not alias indices.
+void OptimizeOverdraw(uint32_t* dst, const uint32_t* indices, size_t indexCount,
+                      const float* positions, size_t positionStride, size_t vertexCount,
+                      float threshold = 1.05f, uint32_t cacheSize = DefaultVertexCacheSize);
+// Builds a remap table that orders vertices by first use in the index buffer, so vertex fetch
+// walks memory linearly. Unreferenced vertices are remapped to ~0u. Returns the new vertex count.
+size_t GenerateVertexFetchRemap(std::vector<uint32_t>& remap, const uint32_t* indices,
+                                size_t indexCount, size_t vertexCount);
+
+template <typename T>
+void WeldVertices(std::vector<T>& vertices, std::vector<uint32_t>& indices) {
+  std::vector<uint32_t> remap;
+  const size_t uniqueCount{GenerateVertexRemap(remap, vertices.data(), vertices.size(), sizeof(T))};
+  if (uniqueCount == vertices.size()) {
+    return;
+  }
+
+  std::vector<T> welded(uniqueCount);
+  RemapVertexBuffer(welded.data(), vertices.data(), vertices.size(), sizeof(T), remap);
+  RemapIndexBuffer(indices.data(), indices.size(), remap);
+  vertices = std::move(welded);
+}
+
+template <typename T>
+void OptimizeVertexFetch(std::vector<T>& vertices, std::vector<uint32_t>& indices) {
+  std::vector<uint32_t> remap;
+  const size_t vertexCount{
+      GenerateVertexFetchRemap(remap, indices.data(), indices.size(), vertices.size())};
+
+  std::vector<T> ordered(vertexCount);
+  RemapVertexBuffer(ordered.data(), vertices.data(), vertices.size(), sizeof(T), remap);
+  RemapIndexBuffer(indices.data(), indices.size(), remap);
+  vertices = std::move(ordered);
+}
+}  // namespace Raven
\ No newline at end of file
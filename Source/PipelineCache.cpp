@@ -0,0 +1,99 @@
+#include "Core.h"
+
+#include "PipelineCache.h"
+
+#include <cstdio>
+
+#include "MeshCache.h"
+
+namespace Raven {
+constexpr static uint32_t gPipelineCacheMagic{0x50505652};  // "RVPP"
+constexpr static uint32_t gPipelineCacheVersion{1};
+
+struct PipelineCacheFileHeader {
+  uint32_t Magic{gPipelineCacheMagic};
+  uint32_t Version{gPipelineCacheVersion};
+  uint32_t VendorID{0};
+  uint32_t DeviceID{0};
+  uint32_t DriverVersion{0};
+  uint8_t PipelineCacheUUID[VK_UUID_SIZE]{};
+  uint64_t DataSize{0};
+  uint64_t DataHash{0};
+};
+
+PipelineCache::PipelineCache(vk::Device device, const vk::PhysicalDeviceProperties& properties,
+                             const std::string& path)
+    : mDevice(device), mProperties(properties), mPath(path) {
+  const void* initialData{nullptr};
+  size_t initialSize{0};
+
+  const MappedFile file(mPath);
+  if (file && file.Size() >= sizeof(PipelineCacheFileHeader)) {
+    const PipelineCacheFileHeader& header{
+        *static_cast<const PipelineCacheFileHeader*>(file.Data())};
+    const void* data{static_cast<const uint8_t*>(file.Data()) + sizeof(header)};
+    if (header.Magic != gPipelineCacheMagic || header.Version != gPipelineCacheVersion ||
+        header.DataSize != file.Size() - sizeof(header)) {
+      Log::Warn("[PipelineCache] {} is malformed, ignoring it.", mPath);
+    } else if (header.VendorID != mProperties.vendorID ||
+               header.DeviceID != mProperties.deviceID ||
+               header.DriverVersion != mProperties.driverVersion ||
+               memcmp(header.PipelineCacheUUID, mProperties.pipelineCacheUUID.data(),
+                      VK_UUID_SIZE) != 0) {
+      Log::Info("[PipelineCache] {} was written by a different device or driver, ignoring it.",
+                mPath);
+    } else if (HashData(data, header.DataSize) != header.DataHash) {
+      Log::Warn("[PipelineCache] {} is corrupt, ignoring it.", mPath);
+    } else {
+      initialData = data;
+      initialSize = header.DataSize;
+    }
+  }
+
+  const vk::PipelineCacheCreateInfo cacheCI({}, initialSize, initialData);
+  mCache = mDevice.createPipelineCacheUnique(cacheCI);
+  mLoadedSize = initialSize;
+
+  Log::Debug("[PipelineCache] {} pipeline cache, {} bytes loaded from {}.",
+             Warm() ? "Warm" : "Cold", mLoadedSize, mPath);
+}
+
+bool PipelineCache::Save() const {
+  const std::vector<uint8_t> data{mDevice.getPipelineCacheData(*mCache)};
+
+  PipelineCacheFileHeader header;
+  header.VendorID = mProperties.vendorID;
+  header.DeviceID = mProperties.deviceID;
+  header.DriverVersion = mProperties.driverVersion;
+  memcpy(header.PipelineCacheUUID, mProperties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+  header.DataSize = data.size();
+  header.DataHash = HashData(data.data(), data.size());
+
+  // Write to a temporary file first, so a crash mid-write never leaves a valid-looking cache.
+  const std::string tempPath{mPath + ".tmp"};
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!file) {
+      file.close();
+      std::remove(tempPath.c_str());
+      return false;
+    }
+  }
+
+  std::remove(mPath.c_str());
+  if (std::rename(tempPath.c_str(), mPath.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    return false;
+  }
+
+  Log::Debug("[PipelineCache] Saved {} bytes to {}.", data.size(), mPath);
+
+  return true;
+}
+}  // namespace Raven
\ No newline at end of file
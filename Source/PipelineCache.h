@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+#include "VulkanCore.h"
+
+namespace Raven {
+// A vk::PipelineCache persisted between runs. The file carries its own header identifying the
+// device and driver that wrote it, as drivers are not required to reject data they did not
+// produce, and a driver update silently invalidates everything compiled before it.
+class PipelineCache final {
+ public:
+  PipelineCache(vk::Device device, const vk::PhysicalDeviceProperties& properties,
+                const std::string& path);
+  PipelineCache(const PipelineCache&) = delete;
+
+  // Writes the cache back to disk. Returns false if the file could not be written.
+  bool Save() const;
+
+  vk::PipelineCache Get() const noexcept { return *mCache; }
+  // Whether valid data was loaded from disk at startup.
+  bool Warm() const noexcept { return mLoadedSize > 0; }
+  size_t LoadedSize() const noexcept { return mLoadedSize; }
+
+ private:
+  vk::Device mDevice;
+  vk::PhysicalDeviceProperties mProperties;
+  std::string mPath;
+  vk::UniquePipelineCache mCache;
+  size_t mLoadedSize{0};
+};
+}  // namespace Raven
\ No newline at end of file
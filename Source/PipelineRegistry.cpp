@@ -0,0 +1,270 @@
+#include "Core.h"
+
+#include "PipelineRegistry.h"
+
+#include <chrono>
+
+#include "JobSystem.h"
+#include "MeshCache.h"
+
+namespace Raven {
+template <typename T>
+static void HashValue(uint64_t& hash, const T& value) {
+  hash = HashData(&value, sizeof(T), hash);
+}
+
+template <typename T>
+static void HashArray(uint64_t& hash, const T* values, size_t count) {
+  HashValue(hash, count);
+  hash = HashData(values, sizeof(T) * count, hash);
+}
+
+/* ==========================================================================================
+ * PipelineBuilder
+ * ========================================================================================== */
+
+uint64_t PipelineBuilder::Hash() const {
+  // Hashed field by field rather than as whole structs, which carry pointers and padding.
+  uint64_t hash{HashData(nullptr, 0)};
+
+  HashValue(hash, ShaderStages.size());
+  for (const auto& stage : ShaderStages) {
+    HashValue(hash, stage.stage);
+    HashValue(hash, static_cast<VkShaderModule>(stage.module));
+    HashArray(hash, stage.pName, strlen(stage.pName));
+  }
+
+  // Vertex input descriptions are plain 32-bit fields with no padding.
+  HashArray(hash, VertexInfo.Bindings.data(), VertexInfo.Bindings.size());
+  HashArray(hash, VertexInfo.Attributes.data(), VertexInfo.Attributes.size());
+
+  HashValue(hash, InputAssembly.topology);
+  HashValue(hash, InputAssembly.primitiveRestartEnable);
+  HashValue(hash, Tesselation.patchControlPoints);
+
+  HashValue(hash, ViewportState.viewportCount);
+  HashValue(hash, ViewportState.scissorCount);
+
+  HashValue(hash, Rasterizer.depthClampEnable);
+  HashValue(hash, Rasterizer.rasterizerDiscardEnable);
+  HashValue(hash, Rasterizer.polygonMode);
+  HashValue(hash, Rasterizer.cullMode);
+  HashValue(hash, Rasterizer.frontFace);
+  HashValue(hash, Rasterizer.depthBiasEnable);
+  HashValue(hash, Rasterizer.depthBiasConstantFactor);
+  HashValue(hash, Rasterizer.depthBiasClamp);
+  HashValue(hash, Rasterizer.depthBiasSlopeFactor);
+  HashValue(hash, Rasterizer.lineWidth);
+
+  HashValue(hash, Multisampling.rasterizationSamples);
+  HashValue(hash, Multisampling.sampleShadingEnable);
+  HashValue(hash, Multisampling.minSampleShading);
+  HashValue(hash, Multisampling.alphaToCoverageEnable);
+  HashValue(hash, Multisampling.alphaToOneEnable);
+
+  HashValue(hash, DepthStencil.depthTestEnable);
+  HashValue(hash, DepthStencil.depthWriteEnable);
+  HashValue(hash, DepthStencil.depthCompareOp);
+  HashValue(hash, DepthStencil.depthBoundsTestEnable);
+  HashValue(hash, DepthStencil.stencilTestEnable);
+  HashValue(hash, DepthStencil.front);
+  HashValue(hash, DepthStencil.back);
+  HashValue(hash, DepthStencil.minDepthBounds);
+  HashValue(hash, DepthStencil.maxDepthBounds);
+
+  HashValue(hash, ColorAttachment);
+  HashValue(hash, ColorBlending.logicOpEnable);
+  HashValue(hash, ColorBlending.logicOp);
+  HashValue(hash, ColorBlending.blendConstants);
+
+  HashArray(hash, DynamicStates.data(), DynamicStates.size());
+
+  HashValue(hash, static_cast<VkPipelineLayout>(Layout));
+  HashValue(hash, static_cast<VkRenderPass>(RenderPass));
+
+  return hash;
+}
+
+/* ==========================================================================================
+ * PipelineRegistry
+ * ========================================================================================== */
+
+PipelineRegistry::PipelineRegistry(vk::Device device, vk::PipelineCache cache, JobSystem& jobs)
+    : mDevice(device), mCache(cache), mJobs(jobs) {}
+
+PipelineRegistry::~PipelineRegistry() { WaitIdle(); }
+
+vk::ShaderModule PipelineRegistry::GetShader(const std::string& path) {
+  auto existing{mShaders.find(path)};
+  if (existing != mShaders.end()) {
+    return *existing->second;
+  }
+
+  vk::UniqueShaderModule shader{LoadShader(path)};
+  if (!shader) {
+    throw std::runtime_error("Failed to load shader!");
+  }
+  auto& entry{mShaders[path]};
+  entry = std::move(shader);
+
+  return *entry;
+}
+
+uint32_t PipelineRegistry::ReloadShader(const std::string& path) {
+  auto existing{mShaders.find(path)};
+  if (existing == mShaders.end()) {
+    return 0;
+  }
+
+  vk::UniqueShaderModule shader{LoadShader(path)};
+  if (!shader) {
+    return 0;
+  }
+  const vk::ShaderModule oldShader{*existing->second};
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  uint32_t rebuilt{0};
+  for (auto& [hash, variant] : mVariants) {
+    bool usesShader{false};
+    for (auto& stage : variant.Builder.ShaderStages) {
+      if (stage.module == oldShader) {
+        stage.module = *shader;
+        usesShader = true;
+      }
+    }
+    if (usesShader) {
+      variant.Generation++;
+      Compile(hash, variant);
+      rebuilt++;
+    }
+  }
+  mRetiredShaders.push_back(std::move(existing->second));
+  existing->second = std::move(shader);
+
+  return rebuilt;
+}
+
+std::shared_ptr<vk::UniquePipeline> PipelineRegistry::Request(const PipelineBuilder& builder) {
+  const uint64_t hash{builder.Hash()};
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto existing{mVariants.find(hash)};
+  if (existing != mVariants.end()) {
+    return existing->second.Pipeline;
+  }
+
+  Variant& variant{mVariants[hash]};
+  variant.Builder = builder;
+  variant.Pipeline = std::make_shared<vk::UniquePipeline>();
+  Compile(hash, variant);
+
+  return variant.Pipeline;
+}
+
+uint32_t PipelineRegistry::Update(uint64_t submittedValue, uint64_t completedValue) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mSubmittedValue = submittedValue;
+  mCompletedValue = completedValue;
+
+  // Pipelines that failed to compile are left as they were, so their users keep drawing either
+  // the previous version or the fallback.
+  uint32_t published{0};
+  for (auto& compiled : mCompiled) {
+    Variant& variant{mVariants[compiled.Hash]};
+    if (!compiled.Pipeline || compiled.Generation != variant.Generation) {
+      continue;
+    }
+    if (*variant.Pipeline) {
+      Log::Debug("[PipelineRegistry] Rebuilt pipeline {:016x}.", compiled.Hash);
+      mRetired.push_back({mSubmittedValue, std::move(*variant.Pipeline)});
+    }
+    *variant.Pipeline = std::move(compiled.Pipeline);
+    published++;
+  }
+  mCompiled.clear();
+
+  while (!mRetired.empty() && mRetired.front().TimelineValue <= mCompletedValue) {
+    mRetired.pop_front();
+  }
+  if (mCompiling.empty()) {
+    mRetiredShaders.clear();
+  }
+
+  return published;
+}
+
+void PipelineRegistry::Wait(const std::shared_ptr<vk::UniquePipeline>& pipeline) {
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCompileCondition.wait(lock, [&]() { return mCompiling.count(pipeline.get()) == 0; });
+  }
+  Update(mSubmittedValue, mCompletedValue);
+}
+
+void PipelineRegistry::WaitIdle() {
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCompileCondition.wait(lock, [this]() { return mCompiling.empty(); });
+  }
+  Update(mSubmittedValue, mCompletedValue);
+}
+
+size_t PipelineRegistry::PipelineCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  return mVariants.size();
+}
+
+size_t PipelineRegistry::PendingCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  return mCompiling.size() + mCompiled.size();
+}
+
+vk::UniqueShaderModule PipelineRegistry::LoadShader(const std::string& path) {
+  // Mappings are page aligned, so the SPIR-V can be handed to the driver without a copy.
+  const MappedFile file(path);
+  if (!file || file.Size() % sizeof(uint32_t) != 0) {
+    Log::Error("[PipelineRegistry] Failed to load shader {}", path);
+    return {};
+  }
+
+  const vk::ShaderModuleCreateInfo shaderModuleCI(
+      {}, file.Size(), static_cast<const uint32_t*>(file.Data()));
+
+  return mDevice.createShaderModuleUnique(shaderModuleCI);
+}
+
+void PipelineRegistry::Compile(uint64_t hash, const Variant& variant) {
+  mCompiling.insert(variant.Pipeline.get());
+
+  // Pipeline caches are internally synchronized, so every worker compiles against the same one.
+  mJobs.Submit([this, hash, builder = variant.Builder, target = variant.Pipeline.get(),
+                generation = variant.Generation]() mutable {
+    RAVEN_PROFILE_SCOPE("CompilePipeline");
+    const auto startTime{std::chrono::high_resolution_clock::now()};
+    vk::UniquePipeline pipeline;
+    try {
+      if (builder.IsCompute()) {
+        pipeline = mDevice
+                       .createComputePipelineUnique(
+                           mCache, static_cast<vk::ComputePipelineCreateInfo>(builder))
+                       .value;
+      } else {
+        pipeline = mDevice.createGraphicsPipelineUnique(mCache, builder).value;
+      }
+    } catch (const std::exception& e) {
+      Log::Error("[PipelineRegistry] Failed to compile pipeline {:016x}: {}", hash, e.what());
+    }
+    Log::Trace("[PipelineRegistry] Compiled pipeline {:016x} in {:.2f}ms.", hash,
+               std::chrono::duration<float, std::chrono::milliseconds::period>(
+                   std::chrono::high_resolution_clock::now() - startTime)
+                   .count());
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCompiled.push_back({hash, generation, std::move(pipeline)});
+    mCompiling.erase(mCompiling.find(target));
+    mCompileCondition.notify_all();
+  });
+}
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "VulkanCore.h"
+
+namespace Raven {
+class JobSystem;
+
+struct VertexDescription final {
+  std::vector<vk::VertexInputAttributeDescription> Attributes;
+  std::vector<vk::VertexInputBindingDescription> Bindings;
+};
+
+// Holds the complete state of a graphics pipeline. The create info pointers are only filled in on
+// conversion, so a builder can be copied and compiled elsewhere. A builder with a single compute
+// stage describes a compute pipeline, and only its shader and layout are used.
+class PipelineBuilder final {
+ public:
+  PipelineBuilder() {
+    InputAssembly =
+        vk::PipelineInputAssemblyStateCreateInfo({}, vk::PrimitiveTopology::eTriangleList, false);
+
+    // Viewport and scissor are set when recording, so pipelines survive swapchain resizes.
+    ViewportState = vk::PipelineViewportStateCreateInfo({}, 1, nullptr, 1, nullptr);
+    DynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+
+    Rasterizer = vk::PipelineRasterizationStateCreateInfo(
+        {}, false, false, vk::PolygonMode::eFill, vk::CullModeFlagBits::eNone,
+        vk::FrontFace::eCounterClockwise, false, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    Multisampling = vk::PipelineMultisampleStateCreateInfo();
+
+    DepthStencil = vk::PipelineDepthStencilStateCreateInfo();
+
+    ColorAttachment = vk::PipelineColorBlendAttachmentState(
+        true, vk::BlendFactor::eSrcAlpha, vk::BlendFactor::eOneMinusSrcAlpha, vk::BlendOp::eAdd,
+        vk::BlendFactor::eOne, vk::BlendFactor::eZero, vk::BlendOp::eAdd,
+        vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
+            vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA);
+    ColorBlending =
+        vk::PipelineColorBlendStateCreateInfo({}, false, vk::LogicOp::eCopy, ColorAttachment);
+  }
+
+  operator vk::GraphicsPipelineCreateInfo() {
+    VertexInput =
+        vk::PipelineVertexInputStateCreateInfo({}, VertexInfo.Bindings, VertexInfo.Attributes);
+    ColorBlending.setAttachments(ColorAttachment);
+    DynamicState = vk::PipelineDynamicStateCreateInfo({}, DynamicStates);
+
+    return vk::GraphicsPipelineCreateInfo({}, ShaderStages, &VertexInput, &InputAssembly,
+                                          &Tesselation, &ViewportState, &Rasterizer, &Multisampling,
+                                          &DepthStencil, &ColorBlending, &DynamicState, Layout,
+                                          RenderPass, 0);
+  }
+
+  operator vk::ComputePipelineCreateInfo() const {
+    return vk::ComputePipelineCreateInfo({}, ShaderStages[0], Layout);
+  }
+
+  bool IsCompute() const noexcept {
+    return ShaderStages.size() == 1 && ShaderStages[0].stage == vk::ShaderStageFlagBits::eCompute;
+  }
+
+  PipelineBuilder& AddShader(vk::ShaderStageFlagBits stage, vk::ShaderModule shader) {
+    ShaderStages.push_back(vk::PipelineShaderStageCreateInfo({}, stage, shader, "main"));
+
+    return *this;
+  }
+
+  PipelineBuilder& ClearShaders() {
+    ShaderStages.clear();
+
+    return *this;
+  }
+
+  template <typename T>
+  PipelineBuilder& SetVertexInput() {
+    VertexInfo = T::GetVertexDescription();
+
+    return *this;
+  }
+
+  PipelineBuilder& EnableDepthBuffer() {
+    DepthStencil = vk::PipelineDepthStencilStateCreateInfo({}, true, true, vk::CompareOp::eLess,
+                                                           false, false, {}, {}, 0.0f, 1.0f);
+
+    return *this;
+  }
+
+  // Hashes every piece of state that affects the compiled pipeline. Shader modules, layouts and
+  // render passes are hashed by handle.
+  uint64_t Hash() const;
+
+  std::vector<vk::PipelineShaderStageCreateInfo> ShaderStages;
+  VertexDescription VertexInfo;
+  vk::PipelineVertexInputStateCreateInfo VertexInput;
+  vk::PipelineInputAssemblyStateCreateInfo InputAssembly;
+  vk::PipelineTessellationStateCreateInfo Tesselation;
+  vk::PipelineViewportStateCreateInfo ViewportState;
+  vk::PipelineRasterizationStateCreateInfo Rasterizer;
+  vk::PipelineMultisampleStateCreateInfo Multisampling;
+  vk::PipelineDepthStencilStateCreateInfo DepthStencil;
+  vk::PipelineColorBlendAttachmentState ColorAttachment;
+  vk::PipelineColorBlendStateCreateInfo ColorBlending;
+  std::vector<vk::DynamicState> DynamicStates;
+  vk::PipelineDynamicStateCreateInfo DynamicState;
+  vk::PipelineLayout Layout;
+  vk::RenderPass RenderPass;
+};
+
+// Owns every shader module and pipeline. Identical builder state always maps to the same
+// pipeline, and new pipelines are compiled on worker threads against a shared pipeline cache.
+// Pipelines are handed out immediately and stay null until Update() publishes them, so callers
+// must be ready to draw with something else in the meantime. Shader functions are not thread safe.
+class PipelineRegistry final {
+ public:
+  PipelineRegistry(vk::Device device, vk::PipelineCache cache, JobSystem& jobs);
+  PipelineRegistry(const PipelineRegistry&) = delete;
+  ~PipelineRegistry();
+
+  // Loads a SPIR-V module, or returns the module already loaded from this path.
+  vk::ShaderModule GetShader(const std::string& path);
+  // Loads the module at path again, and rebuilds every pipeline using it in the background. The
+  // old pipelines stay in place until the new ones are published. Returns the number of pipelines
+  // being rebuilt.
+  uint32_t ReloadShader(const std::string& path);
+  std::shared_ptr<vk::UniquePipeline> Request(const PipelineBuilder& builder);
+  // Publishes every pipeline that has finished compiling. Must not be called while a command
+  // buffer that may bind a newly published pipeline is being recorded. Pipelines replaced by a
+  // rebuild may still be in use by submitted frames, so they are kept until completedValue
+  // reaches submittedValue, the last timeline value that may have used them.
+  uint32_t Update(uint64_t submittedValue, uint64_t completedValue);
+  // Blocks until the given pipeline has finished compiling, then publishes it.
+  void Wait(const std::shared_ptr<vk::UniquePipeline>& pipeline);
+  void WaitIdle();
+
+  size_t PipelineCount() const;
+  size_t PendingCount() const;
+
+ private:
+  struct Variant {
+    PipelineBuilder Builder;
+    std::shared_ptr<vk::UniquePipeline> Pipeline;
+    // Bumped by every rebuild, so a compile that finishes after a newer one started is dropped.
+    uint32_t Generation{0};
+  };
+
+  struct CompiledPipeline {
+    uint64_t Hash{0};
+    uint32_t Generation{0};
+    vk::UniquePipeline Pipeline;
+  };
+
+  struct RetiredPipeline {
+    uint64_t TimelineValue{0};
+    vk::UniquePipeline Pipeline;
+  };
+
+  vk::UniqueShaderModule LoadShader(const std::string& path);
+  // Must be called with mMutex held.
+  void Compile(uint64_t hash, const Variant& variant);
+
+  vk::Device mDevice;
+  vk::PipelineCache mCache;
+  JobSystem& mJobs;
+
+  std::unordered_map<std::string, vk::UniqueShaderModule> mShaders;
+
+  mutable std::mutex mMutex;
+  std::condition_variable mCompileCondition;
+  // Keyed by the hash each variant was first requested with. Rebuilds keep the original key.
+  std::unordered_map<uint64_t, Variant> mVariants;
+  std::unordered_multiset<const vk::UniquePipeline*> mCompiling;
+  std::vector<CompiledPipeline> mCompiled;
+  std::deque<RetiredPipeline> mRetired;
+  // Modules replaced by a reload, kept until no compile can still be reading them.
+  std::vector<vk::UniqueShaderModule> mRetiredShaders;
+  uint64_t mSubmittedValue{0};
+  uint64_t mCompletedValue{0};
+};
+}  // namespace Raven
\ No newline at end of file
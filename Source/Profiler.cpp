@@ -0,0 +1,129 @@
+#include "Core.h"
+
+#include "Profiler.h"
+
+#include <chrono>
+#include <mutex>
+
+namespace Raven {
+std::atomic<bool> Profiler::sEnabled{false};
+
+// Each thread can record this many zones before further zones are dropped.
+constexpr static uint32_t gEventsPerThread{64 * 1024};
+
+namespace {
+struct ProfileEvent {
+  const char* Name;
+  int64_t StartNs;
+  int64_t EndNs;
+};
+
+// Written only by the owning thread. Count is published with release ordering after each event, so
+// the exporter can read every event below it without a lock.
+struct ThreadBuffer {
+  uint32_t ThreadID{0};
+  std::string Name;
+  std::unique_ptr<ProfileEvent[]> Events;
+  std::atomic<uint32_t> Count{0};
+  std::atomic<uint32_t> Dropped{0};
+};
+}  // namespace
+
+static const std::chrono::steady_clock::time_point gEpoch{std::chrono::steady_clock::now()};
+// Guards registration of new threads and their names, never the events themselves.
+static std::mutex gBufferMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> gBuffers;
+static thread_local ThreadBuffer* gThreadBuffer{nullptr};
+
+static ThreadBuffer& GetThreadBuffer() {
+  if (gThreadBuffer == nullptr) {
+    std::lock_guard<std::mutex> lock(gBufferMutex);
+    auto buffer{std::make_unique<ThreadBuffer>()};
+    buffer->ThreadID = static_cast<uint32_t>(gBuffers.size());
+    buffer->Name = fmt::format("Thread {}", buffer->ThreadID);
+    gThreadBuffer = buffer.get();
+    gBuffers.push_back(std::move(buffer));
+  }
+
+  return *gThreadBuffer;
+}
+
+int64_t Profiler::Now() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              gEpoch)
+      .count();
+}
+
+void Profiler::Record(const char* name, int64_t startNs, int64_t endNs) noexcept {
+  ThreadBuffer& buffer{GetThreadBuffer()};
+  // Allocated on first use, so threads that are only named do not reserve any event storage.
+  if (!buffer.Events) {
+    buffer.Events.reset(new (std::nothrow) ProfileEvent[gEventsPerThread]);
+  }
+
+  const uint32_t index{buffer.Count.load(std::memory_order_relaxed)};
+  if (!buffer.Events || index >= gEventsPerThread) {
+    buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.Events[index] = {name, startNs, endNs};
+  buffer.Count.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+  ThreadBuffer& buffer{GetThreadBuffer()};
+  std::lock_guard<std::mutex> lock(gBufferMutex);
+  buffer.Name = name;
+}
+
+bool Profiler::WriteTrace(const std::string& path) {
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    Log::Error("[Profiler] Failed to open {} for writing.", path);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(gBufferMutex);
+  uint64_t eventCount{0};
+  uint64_t droppedCount{0};
+  bool first{true};
+  const auto separator{[&first]() {
+    const char* sep{first ? "\n" : ",\n"};
+    first = false;
+    return sep;
+  }};
+
+  // Timestamps are in microseconds. Zone names are string literals, and are written unescaped.
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (const auto& buffer : gBuffers) {
+    file << fmt::format("{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},",
+                        separator(), buffer->ThreadID)
+         << fmt::format("\"args\":{{\"name\":\"{}\"}}}}", buffer->Name);
+
+    const uint32_t count{buffer->Count.load(std::memory_order_acquire)};
+    for (uint32_t i = 0; i < count; i++) {
+      const ProfileEvent& event{buffer->Events[i]};
+      file << fmt::format(
+          "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+          separator(), event.Name, buffer->ThreadID, event.StartNs / 1000.0,
+          (event.EndNs - event.StartNs) / 1000.0);
+    }
+    eventCount += count;
+    droppedCount += buffer->Dropped.load(std::memory_order_relaxed);
+  }
+  file << "\n]}\n";
+
+  if (!file) {
+    Log::Error("[Profiler] Failed to write trace to {}.", path);
+    return false;
+  }
+
+  if (droppedCount > 0) {
+    Log::Warn("[Profiler] {} zones were dropped after filling their thread's buffer.",
+              droppedCount);
+  }
+  Log::Info("[Profiler] Wrote {} zones from {} threads to {}.", eventCount, gBuffers.size(), path);
+
+  return true;
+}
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Profiling zones can be compiled out entirely by building with RAVEN_PROFILING=0. When compiled in
+// but not enabled, a zone costs one relaxed atomic load.
+#ifndef RAVEN_PROFILING
+#define RAVEN_PROFILING 1
+#endif
+
+#define RAVEN_PROFILE_CONCAT_(a, b) a##b
+#define RAVEN_PROFILE_CONCAT(a, b) RAVEN_PROFILE_CONCAT_(a, b)
+#if RAVEN_PROFILING
+// Times the rest of the enclosing scope. name must be a string literal, or otherwise outlive the
+// profiler, as only the pointer is stored.
+#define RAVEN_PROFILE_SCOPE(name) \
+  const ::Raven::ProfileScope RAVEN_PROFILE_CONCAT(ravenProfileScope, __LINE__) { name }
+#else
+#define RAVEN_PROFILE_SCOPE(name)
+#endif
+
+namespace Raven {
+// CPU profiler. Zones are written into a fixed-size buffer owned by the recording thread, so
+// recording never takes a lock. The buffers are kept until exit and exported once, as a Chrome
+// trace that can be opened in chrome://tracing or ui.perfetto.dev.
+class Profiler {
+ public:
+  static void SetEnabled(bool enabled) noexcept {
+    sEnabled.store(enabled, std::memory_order_relaxed);
+  }
+  static bool IsEnabled() noexcept { return sEnabled.load(std::memory_order_relaxed); }
+
+  // Nanoseconds since the profiler's epoch.
+  static int64_t Now() noexcept;
+  static void Record(const char* name, int64_t startNs, int64_t endNs) noexcept;
+  // Names the calling thread in exported traces.
+  static void SetThreadName(const std::string& name);
+
+  // Writes every zone recorded so far. Recording should be disabled first, as zones still being
+  // recorded while the trace is written may be missed.
+  static bool WriteTrace(const std::string& path);
+
+ private:
+  static std::atomic<bool> sEnabled;
+};
+
+class ProfileScope final {
+ public:
+  explicit ProfileScope(const char* name) noexcept
+      : mName(Profiler::IsEnabled() ? name : nullptr) {
+    if (mName) {
+      mStart = Profiler::Now();
+    }
+  }
+  ProfileScope(const ProfileScope&) = delete;
+  ~ProfileScope() noexcept {
+    if (mName) {
+      Profiler::Record(mName, mStart, Profiler::Now());
+    }
+  }
+
+ private:
+  const char* mName;
+  int64_t mStart{0};
+};
+}  // namespace Raven
\ No newline at end of file
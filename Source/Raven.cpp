@@ -1,29 +1,76 @@
 #include "Core.h"
 
+#include <cctype>
+
 #include "Application.h"
+#include "Benchmarks.h"
 #include "Win32.h"
 
 using namespace Raven;
 
-int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
+static void ShowFatalError(const std::string& msg) {
+#ifdef _WIN32
+  ::MessageBoxA(NULL, msg.c_str(), "Raven Exception", MB_OK | MB_ICONERROR);
+#endif
+}
+
+static int RavenMain(const std::vector<const char*>& cmdArgs) {
   Log::Initialize();
   Log::SetLevel(Raven::Log::Level::Debug);
 
-  try {
-    const std::vector<const char*> cmdArgs(__argv, __argv + __argc);
+  // CPU-only benchmarks run instead of the renderer.
+  // Usage: --bench-culling|--bench-scene|--bench-mesh [objectCount] [iterations]
+  std::string benchmark;
+  uint32_t benchObjects{100000};
+  uint32_t benchIterations{100};
+  for (size_t i = 1; i < cmdArgs.size(); i++) {
+    const std::string arg{cmdArgs[i]};
+    if (arg == "--bench-culling" || arg == "--bench-scene" || arg == "--bench-mesh") {
+      benchmark = arg;
+      if (i + 1 < cmdArgs.size() && std::isdigit(cmdArgs[i + 1][0])) {
+        benchObjects = std::stoul(cmdArgs[++i]);
+      }
+      if (i + 1 < cmdArgs.size() && std::isdigit(cmdArgs[i + 1][0])) {
+        benchIterations = std::stoul(cmdArgs[++i]);
+      }
+    }
+  }
 
-    Application app(cmdArgs);
-    app.Run();
+  int exitCode{0};
+  try {
+    if (benchmark == "--bench-culling") {
+      exitCode = RunCullingBenchmark(benchObjects, benchIterations);
+    } else if (benchmark == "--bench-scene") {
+      exitCode = RunSceneBenchmark(benchObjects, benchIterations);
+    } else if (benchmark == "--bench-mesh") {
+      exitCode = RunMeshBenchmark(benchObjects, benchIterations);
+    } else {
+      Application app(cmdArgs);
+      app.Run();
+    }
   } catch (const std::exception& e) {
     const std::string alert{fmt::format("An application exception has occurred.\n{}\n\n{}",
                                         typeid(e).name(), e.what())};
     Log::Fatal(alert);
-    ::MessageBoxA(NULL, alert.c_str(), "Raven Exception", MB_OK | MB_ICONERROR);
+    ShowFatalError(alert);
+    exitCode = 1;
   } catch (...) {
     Log::Fatal("An unknown application exception has occurred.");
-    ::MessageBoxA(NULL, "An unknown application exception has occurred.", "Raven Exception",
-                  MB_OK | MB_ICONERROR);
+    ShowFatalError("An unknown application exception has occurred.");
+    exitCode = 1;
   }
 
   Log::Shutdown();
-}
\ No newline at end of file
+
+  return exitCode;
+}
+
+#ifdef _WIN32
+int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
+  return RavenMain(std::vector<const char*>(__argv, __argv + __argc));
+}
+#else
+int main(int argc, char** argv) {
+  return RavenMain(std::vector<const char*>(argv, argv + argc));
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "Core.h"
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+
+namespace Raven {
+uint32_t QuantizeDepth(float distance, float maxDistance) noexcept {
+  constexpr uint32_t maxDepth{(1u << SortKeyDepthBits) - 1};
+  const float normalized{std::clamp(distance / maxDistance, 0.0f, 1.0f)};
+
+  return static_cast<uint32_t>(normalized * maxDepth);
+}
+
+void RenderQueue::Sort() {
+  mUnsortedStats = CountBinds(mEntries);
+
+  // LSD radix sort, one byte per pass. Passes where every key has the same byte (such as the
+  // upper pipeline bits in a small scene) are skipped entirely.
+  mScratch.resize(mEntries.size());
+  for (uint32_t shift = 0; shift < 64; shift += 8) {
+    std::array<uint32_t, 256> counts{};
+    for (const Entry& entry : mEntries) {
+      counts[(entry.Key >> shift) & 0xFF]++;
+    }
+    if (mEntries.empty() || counts[(mEntries[0].Key >> shift) & 0xFF] == mEntries.size()) {
+      continue;
+    }
+
+    uint32_t offset{0};
+    for (uint32_t& count : counts) {
+      const uint32_t bucketSize{count};
+      count = offset;
+      offset += bucketSize;
+    }
+    for (const Entry& entry : mEntries) {
+      mScratch[counts[(entry.Key >> shift) & 0xFF]++] = entry;
+    }
+    mEntries.swap(mScratch);
+  }
+
+  mSortedStats = CountBinds(mEntries);
+}
+
+RenderQueueStats RenderQueue::CountBinds(const std::vector<Entry>& entries) noexcept {
+  constexpr uint64_t meshMask{(1ull << SortKeyMeshBits) - 1};
+
+  RenderQueueStats stats;
+  uint64_t lastState{std::numeric_limits<uint64_t>::max()};
+  for (const Entry& entry : entries) {
+    const uint64_t state{GetStateKey(entry.Key)};
+    if (state == lastState) {
+      continue;
+    }
+    const uint64_t changed{state ^ lastState};
+    if (changed >> (SortKeyMaterialBits + SortKeyMeshBits)) {
+      stats.PipelineBinds++;
+    }
+    // Materials own their descriptor sets, and a pipeline change implies a material change.
+    if (changed >> SortKeyMeshBits) {
+      stats.DescriptorSetBinds++;
+    }
+    if (changed & meshMask) {
+      stats.MeshBinds++;
+    }
+    lastState = state;
+  }
+
+  return stats;
+}
+}  // namespace Raven
\ No newline at end of file
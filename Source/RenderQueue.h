@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace Raven {
+// Draw sort keys, from most to least significant: pipeline, descriptor set (material), mesh and
+// view depth. Sorting by key orders draws by the cost of the state they change, and draws front
+// to back within each group. The depth bits are left out of Scene sort keys and filled in per
+// frame.
+constexpr uint32_t SortKeyDepthBits{20};
+constexpr uint32_t SortKeyMeshBits{16};
+constexpr uint32_t SortKeyMaterialBits{16};
+constexpr uint32_t SortKeyPipelineBits{12};
+
+// Each field must fit its bit width, or it would spill into the next field and merge draws of
+// different state. Scene enforces this for its handles. Depth is masked to its bits.
+constexpr uint64_t MakeSortKey(uint32_t pipeline, uint32_t material, uint32_t mesh,
+                               uint32_t depth) noexcept {
+  assert(pipeline < (1u << SortKeyPipelineBits));
+  assert(material < (1u << SortKeyMaterialBits));
+  assert(mesh < (1u << SortKeyMeshBits));
+  depth &= (1u << SortKeyDepthBits) - 1;
+
+  return static_cast<uint64_t>(pipeline)
+             << (SortKeyMaterialBits + SortKeyMeshBits + SortKeyDepthBits) |
+         static_cast<uint64_t>(material) << (SortKeyMeshBits + SortKeyDepthBits) |
+         static_cast<uint64_t>(mesh) << SortKeyDepthBits | depth;
+}
+// Strips the depth bits. Objects with the same state key can share an instanced draw.
+constexpr uint64_t GetStateKey(uint64_t key) noexcept { return key >> SortKeyDepthBits; }
+// Maps a view distance in [0, maxDistance] onto the depth bits of a sort key.
+uint32_t QuantizeDepth(float distance, float maxDistance) noexcept;
+
+// How many times each kind of state would be bound when recording the queue in its current order.
+struct RenderQueueStats {
+  uint32_t PipelineBinds{0};
+  uint32_t DescriptorSetBinds{0};
+  uint32_t MeshBinds{0};
+
+  uint32_t Total() const noexcept { return PipelineBinds + DescriptorSetBinds + MeshBinds; }
+};
+
+// The list of objects to draw this frame, keyed for sorting.
+class RenderQueue final {
+ public:
+  struct Entry {
+    uint64_t Key{0};
+    uint32_t Object{0};
+  };
+
+  void Clear() noexcept { mEntries.clear(); }
+  void Push(uint64_t key, uint32_t object) { mEntries.push_back({key, object}); }
+  // Radix sorts the entries by key. Bind counts are gathered before and after sorting.
+  void Sort();
+
+  const std::vector<Entry>& Entries() const noexcept { return mEntries; }
+  size_t Size() const noexcept { return mEntries.size(); }
+  const RenderQueueStats& UnsortedStats() const noexcept { return mUnsortedStats; }
+  const RenderQueueStats& SortedStats() const noexcept { return mSortedStats; }
+
+ private:
+  static RenderQueueStats CountBinds(const std::vector<Entry>& entries) noexcept;
+
+  std::vector<Entry> mEntries;
+  std::vector<Entry> mScratch;
+  RenderQueueStats mUnsortedStats;
+  RenderQueueStats mSortedStats;
+};
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "Core.h"
+
+#include "Scene.h"
+
+#include "Application.h"
+#include "RenderQueue.h"
+
+namespace Raven {
+MeshHandle Scene::AddMesh(std::shared_ptr<Mesh> mesh) {
+  // Handles are packed into draw sort keys, which only have room for so many of each.
+  if (mMeshes.size() >= (1u << SortKeyMeshBits)) {
+    throw std::runtime_error("Too many meshes for the draw sort key!");
+  }
+  mMeshes.push_back(std::move(mesh));
+
+  return static_cast<MeshHandle>(mMeshes.size() - 1);
+}
+
+MaterialHandle Scene::AddMaterial(std::shared_ptr<Material> material) {
+  uint32_t pipeline{mPipelineCount};
+  for (size_t i = 0; i < mMaterials.size(); i++) {
+    if (mMaterials[i]->Pipeline == material->Pipeline) {
+      pipeline = mMaterialPipelines[i];
+      break;
+    }
+  }
+  if (mMaterials.size() >= (1u << SortKeyMaterialBits)) {
+    throw std::runtime_error("Too many materials for the draw sort key!");
+  }
+  if (pipeline == mPipelineCount) {
+    if (mPipelineCount >= (1u << SortKeyPipelineBits)) {
+      throw std::runtime_error("Too many pipelines for the draw sort key!");
+    }
+    mPipelineCount++;
+  }
+  mMaterialPipelines.push_back(pipeline);
+  mMaterials.push_back(std::move(material));
+
+  return static_cast<MaterialHandle>(mMaterials.size() - 1);
+}
+
+ObjectHandle Scene::CreateObject(MeshHandle mesh, MaterialHandle material,
+                                 const glm::mat4& transform) {
+  mTransforms.push_back(transform);
+  mObjectMeshes.push_back(mesh);
+  mObjectMaterials.push_back(material);
+  mSortKeys.push_back(MakeSortKey(mMaterialPipelines[material], material, mesh, 0));
+  mTransformVersions.push_back(++mVersion);
+
+  return static_cast<ObjectHandle>(mTransforms.size() - 1);
+}
+
+void Scene::SetTransform(ObjectHandle object, const glm::mat4& transform) noexcept {
+  mTransforms[object] = transform;
+  mTransformVersions[object] = ++mVersion;
+}
+}  // namespace Raven
\ No newline at end of file
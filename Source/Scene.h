@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Raven {
+struct Material;
+struct Mesh;
+
+using MeshHandle = uint32_t;
+using MaterialHandle = uint32_t;
+using ObjectHandle = uint32_t;
+constexpr uint32_t InvalidHandle{std::numeric_limits<uint32_t>::max()};
+
+// Flat storage for everything that gets drawn. Objects are stored as parallel arrays indexed by
+// ObjectHandle, and refer to meshes and materials by 32-bit handles, so walking the scene touches
+// contiguous memory and no reference counts. The scene owns its meshes and materials.
+class Scene final {
+ public:
+  MeshHandle AddMesh(std::shared_ptr<Mesh> mesh);
+  MaterialHandle AddMaterial(std::shared_ptr<Material> material);
+  Mesh& GetMesh(MeshHandle handle) const noexcept { return *mMeshes[handle]; }
+  Material& GetMaterial(MaterialHandle handle) const noexcept { return *mMaterials[handle]; }
+
+  ObjectHandle CreateObject(MeshHandle mesh, MaterialHandle material, const glm::mat4& transform);
+  // Marks the transform as changed, so that it is uploaded again on the next frame.
+  void SetTransform(ObjectHandle object, const glm::mat4& transform) noexcept;
+
+  size_t ObjectCount() const noexcept { return mTransforms.size(); }
+  const std::vector<glm::mat4>& Transforms() const noexcept { return mTransforms; }
+  const std::vector<MeshHandle>& ObjectMeshes() const noexcept { return mObjectMeshes; }
+  const std::vector<MaterialHandle>& ObjectMaterials() const noexcept { return mObjectMaterials; }
+  // Render queue sort keys with the depth bits left zero. See MakeSortKey().
+  const std::vector<uint64_t>& SortKeys() const noexcept { return mSortKeys; }
+  // The scene version at which each object's transform last changed. Consumers that keep a copy of
+  // the transforms only need to update objects newer than the version they last saw.
+  const std::vector<uint64_t>& TransformVersions() const noexcept { return mTransformVersions; }
+  // Incremented whenever objects are added or moved.
+  uint64_t Version() const noexcept { return mVersion; }
+
+ private:
+  std::vector<glm::mat4> mTransforms;
+  std::vector<MeshHandle> mObjectMeshes;
+  std::vector<MaterialHandle> mObjectMaterials;
+  std::vector<uint64_t> mSortKeys;
+  std::vector<uint64_t> mTransformVersions;
+
+  std::vector<std::shared_ptr<Mesh>> mMeshes;
+  std::vector<std::shared_ptr<Material>> mMaterials;
+  // Materials that share a pipeline share an index here, so their draws sort together.
+  std::vector<uint32_t> mMaterialPipelines;
+  uint32_t mPipelineCount{0};
+  uint64_t mVersion{0};
+};
+}  // namespace Raven
\ No newline at end of file
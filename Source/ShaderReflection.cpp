@@ -0,0 +1,162 @@
+#include "Core.h"
+
+#include "ShaderReflection.h"
+
+#include <algorithm>
+#include <json.hpp>
+
+namespace Raven {
+// Uniform buffers are always bound with dynamic offsets, as per-frame uniforms are sub-allocated
+// from one buffer by the frame's UniformAllocator.
+constexpr static std::array<std::pair<const char*, vk::DescriptorType>, 7> gResourceTypes{
+    {{"ubos", vk::DescriptorType::eUniformBufferDynamic},
+     {"ssbos", vk::DescriptorType::eStorageBuffer},
+     {"textures", vk::DescriptorType::eCombinedImageSampler},
+     {"separate_images", vk::DescriptorType::eSampledImage},
+     {"separate_samplers", vk::DescriptorType::eSampler},
+     {"images", vk::DescriptorType::eStorageImage},
+     {"subpass_inputs", vk::DescriptorType::eInputAttachment}}};
+
+static vk::ShaderStageFlagBits GetShaderStage(const std::string& mode) {
+  if (mode == "vert") {
+    return vk::ShaderStageFlagBits::eVertex;
+  } else if (mode == "tesc") {
+    return vk::ShaderStageFlagBits::eTessellationControl;
+  } else if (mode == "tese") {
+    return vk::ShaderStageFlagBits::eTessellationEvaluation;
+  } else if (mode == "geom") {
+    return vk::ShaderStageFlagBits::eGeometry;
+  } else if (mode == "frag") {
+    return vk::ShaderStageFlagBits::eFragment;
+  } else if (mode == "comp") {
+    return vk::ShaderStageFlagBits::eCompute;
+  }
+
+  Log::Error("[LoadShaderReflection] Unknown shader stage \"{}\"", mode);
+  throw std::runtime_error("Unknown shader stage!");
+}
+
+static vk::Format GetInputFormat(const std::string& type) {
+  const std::unordered_map<std::string, vk::Format> formats{
+      {"float", vk::Format::eR32Sfloat},       {"vec2", vk::Format::eR32G32Sfloat},
+      {"vec3", vk::Format::eR32G32B32Sfloat},  {"vec4", vk::Format::eR32G32B32A32Sfloat},
+      {"int", vk::Format::eR32Sint},           {"ivec2", vk::Format::eR32G32Sint},
+      {"ivec3", vk::Format::eR32G32B32Sint},   {"ivec4", vk::Format::eR32G32B32A32Sint},
+      {"uint", vk::Format::eR32Uint},          {"uvec2", vk::Format::eR32G32Uint},
+      {"uvec3", vk::Format::eR32G32B32Uint},   {"uvec4", vk::Format::eR32G32B32A32Uint}};
+  const auto format{formats.find(type)};
+
+  return format == formats.end() ? vk::Format::eUndefined : format->second;
+}
+
+bool LoadShaderReflection(const std::string& spirvPath, ShaderReflection& reflection) {
+  const std::string path{spirvPath + ".json"};
+  std::ifstream file(path);
+  if (!file) {
+    Log::Error("[LoadShaderReflection] Failed to open {}", path);
+    return false;
+  }
+
+  reflection = {};
+  try {
+    const nlohmann::json json(nlohmann::json::parse(file));
+    reflection.Stage = GetShaderStage(json.at("entryPoints").at(0).at("mode").get<std::string>());
+
+    for (const auto& [key, type] : gResourceTypes) {
+      if (json.count(key) == 0) {
+        continue;
+      }
+      for (const auto& resource : json.at(key)) {
+        uint32_t count{1};
+        if (resource.count("array") > 0) {
+          // Runtime sized arrays are reported with a size of zero.
+          for (const auto& size : resource.at("array")) {
+            count *= std::max(size.get<uint32_t>(), 1u);
+          }
+        }
+        reflection.Resources.push_back(
+            {resource.value("set", 0u),
+             vk::DescriptorSetLayoutBinding(resource.at("binding").get<uint32_t>(), type, count,
+                                            reflection.Stage)});
+      }
+    }
+
+    if (json.count("push_constants") > 0) {
+      for (const auto& block : json.at("push_constants")) {
+        reflection.PushConstants.emplace_back(reflection.Stage, 0,
+                                              block.at("block_size").get<uint32_t>());
+      }
+    }
+
+    if (reflection.Stage == vk::ShaderStageFlagBits::eVertex && json.count("inputs") > 0) {
+      for (const auto& input : json.at("inputs")) {
+        reflection.Inputs.push_back({input.at("location").get<uint32_t>(),
+                                     GetInputFormat(input.at("type").get<std::string>())});
+      }
+    }
+  } catch (const std::exception& e) {
+    Log::Error("[LoadShaderReflection] Failed to parse {}: {}", path, e.what());
+    return false;
+  }
+
+  return true;
+}
+
+ShaderLayout& ShaderLayout::AddStage(const ShaderReflection& reflection) {
+  for (const auto& resource : reflection.Resources) {
+    if (resource.Set >= mSets.size()) {
+      mSets.resize(resource.Set + 1);
+    }
+
+    auto& bindings{mSets[resource.Set]};
+    bool merged{false};
+    for (auto& binding : bindings) {
+      if (binding.binding != resource.Binding.binding) {
+        continue;
+      }
+      if (binding.descriptorType != resource.Binding.descriptorType) {
+        Log::Error("[ShaderLayout] Shader stages disagree on the type of set {} binding {}.",
+                   resource.Set, binding.binding);
+        throw std::runtime_error("Shader stages disagree on a descriptor type!");
+      }
+      binding.stageFlags |= resource.Binding.stageFlags;
+      binding.descriptorCount = std::max(binding.descriptorCount, resource.Binding.descriptorCount);
+      merged = true;
+      break;
+    }
+    if (!merged) {
+      bindings.push_back(resource.Binding);
+    }
+  }
+
+  // Every stage shares a single push constant range starting at offset zero.
+  for (const auto& range : reflection.PushConstants) {
+    if (mPushConstants.empty()) {
+      mPushConstants.push_back(range);
+    } else {
+      mPushConstants[0].stageFlags |= range.stageFlags;
+      mPushConstants[0].size = std::max(mPushConstants[0].size, range.size);
+    }
+  }
+
+  mVertexInputs.insert(mVertexInputs.end(), reflection.Inputs.begin(), reflection.Inputs.end());
+
+  return *this;
+}
+
+ShaderLayout& ShaderLayout::AddStage(const std::string& spirvPath) {
+  ShaderReflection reflection;
+  if (!LoadShaderReflection(spirvPath, reflection)) {
+    throw std::runtime_error("Failed to load shader reflection!");
+  }
+
+  return AddStage(reflection);
+}
+
+const std::vector<vk::DescriptorSetLayoutBinding>& ShaderLayout::GetSetBindings(
+    uint32_t set) const {
+  const static std::vector<vk::DescriptorSetLayoutBinding> empty;
+
+  return set < mSets.size() ? mSets[set] : empty;
+}
+}  // namespace Raven
\ No newline at end of file
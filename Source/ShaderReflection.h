@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "VulkanCore.h"
+
+namespace Raven {
+struct ShaderResource {
+  uint32_t Set{0};
+  vk::DescriptorSetLayoutBinding Binding;
+};
+
+struct ShaderInput {
+  uint32_t Location{0};
+  vk::Format Format{vk::Format::eUndefined};
+};
+
+// The resource interface of one shader stage, read from the reflection JSON that the shader build
+// writes next to every SPIR-V module.
+struct ShaderReflection {
+  vk::ShaderStageFlagBits Stage{vk::ShaderStageFlagBits::eVertex};
+  std::vector<ShaderResource> Resources;
+  std::vector<vk::PushConstantRange> PushConstants;
+  // Vertex shaders only.
+  std::vector<ShaderInput> Inputs;
+};
+
+bool LoadShaderReflection(const std::string& spirvPath, ShaderReflection& reflection);
+
+// The combined resource interface of a group of stages, used to build descriptor set and pipeline
+// layouts. Stages that declare the same binding share it, so it must agree on type.
+class ShaderLayout final {
+ public:
+  ShaderLayout& AddStage(const ShaderReflection& reflection);
+  // Throws if the reflection cannot be loaded.
+  ShaderLayout& AddStage(const std::string& spirvPath);
+
+  uint32_t SetCount() const noexcept { return static_cast<uint32_t>(mSets.size()); }
+  const std::vector<vk::DescriptorSetLayoutBinding>& GetSetBindings(uint32_t set) const;
+  const std::vector<vk::PushConstantRange>& GetPushConstants() const noexcept {
+    return mPushConstants;
+  }
+  const std::vector<ShaderInput>& GetVertexInputs() const noexcept { return mVertexInputs; }
+
+ private:
+  std::vector<std::vector<vk::DescriptorSetLayoutBinding>> mSets;
+  std::vector<vk::PushConstantRange> mPushConstants;
+  std::vector<ShaderInput> mVertexInputs;
+};
+}  // namespace Raven
\ No newline at end of file
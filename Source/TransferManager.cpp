@@ -0,0 +1,188 @@
+#include "Core.h"
+
+#include "TransferManager.h"
+
+namespace Raven {
+constexpr static vk::DeviceSize gRingAlignment{16};
+
+TransferManager::TransferManager(vk::Device device, DeviceAllocator& allocator,
+                                 vk::Queue transferQueue, uint32_t transferFamily,
+                                 uint32_t graphicsFamily, vk::DeviceSize ringSize)
+    : mDevice(device),
+      mTransferQueue(transferQueue),
+      mTransferFamily(transferFamily),
+      mGraphicsFamily(graphicsFamily),
+      mRingSize(ringSize) {
+  mRing = allocator.CreateBuffer(
+      mRingSize, vk::BufferUsageFlagBits::eTransferSrc,
+      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+
+  const vk::CommandPoolCreateInfo poolCI(vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+                                             vk::CommandPoolCreateFlagBits::eTransient,
+                                         mTransferFamily);
+  mCommandPool = mDevice.createCommandPoolUnique(poolCI);
+
+  const vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfo> timelineCI{
+      {}, {vk::SemaphoreType::eTimeline, 0}};
+  mTimeline = mDevice.createSemaphoreUnique(timelineCI.get());
+}
+
+TransferManager::~TransferManager() { WaitIdle(); }
+
+void TransferManager::Upload(const Buffer& dst, const void* data, vk::DeviceSize size,
+                             vk::DeviceSize dstOffset) {
+  // Nothing is copied, so there is no ownership to transfer either.
+  if (size == 0) {
+    return;
+  }
+
+  // Large uploads are split so that a single copy never needs more than a quarter of the ring.
+  const vk::DeviceSize maxChunk{mRingSize / 4};
+  const uint8_t* src{static_cast<const uint8_t*>(data)};
+  vk::DeviceSize copied{0};
+  while (copied < size) {
+    const vk::DeviceSize chunk{std::min(size - copied, maxChunk)};
+    const vk::DeviceSize ringOffset{ReserveRing(chunk)};
+    memcpy(static_cast<uint8_t*>(mRing.Memory.Mapped) + ringOffset, src + copied, chunk);
+
+    if (!mRecording) {
+      mRecording = GetCommandBuffer();
+      mRecording.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    }
+    const vk::BufferCopy region(ringOffset, dstOffset + copied, chunk);
+    mRecording.copyBuffer(*mRing.Handle, *dst.Handle, region);
+
+    copied += chunk;
+  }
+
+  // When the transfer queue belongs to a different family, ownership of the destination has to be
+  // released here and acquired again on the graphics queue before it can be read there.
+  if (mTransferFamily != mGraphicsFamily) {
+    const vk::BufferMemoryBarrier release(vk::AccessFlagBits::eTransferWrite, {}, mTransferFamily,
+                                          mGraphicsFamily, *dst.Handle, dstOffset, size);
+    mRecording.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                               vk::PipelineStageFlagBits::eBottomOfPipe, {}, nullptr, release,
+                               nullptr);
+
+    const vk::BufferMemoryBarrier acquire(
+        {},
+        vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eVertexAttributeRead |
+            vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eShaderRead |
+            vk::AccessFlagBits::eUniformRead,
+        mTransferFamily, mGraphicsFamily, *dst.Handle, dstOffset, size);
+    mRecordingAcquires.push_back({acquire, 0});
+  }
+}
+
+uint64_t TransferManager::Flush() {
+  if (!mRecording) {
+    return mSubmittedValue;
+  }
+
+  mRecording.end();
+
+  const uint64_t signalValue{++mSubmittedValue};
+  const vk::TimelineSemaphoreSubmitInfo timelineInfo(nullptr, signalValue);
+  const vk::SubmitInfo submitInfo(nullptr, nullptr, mRecording, *mTimeline);
+  const vk::StructureChain<vk::SubmitInfo, vk::TimelineSemaphoreSubmitInfo> submitChain{
+      submitInfo, timelineInfo};
+  mTransferQueue.submit(submitChain.get(), nullptr);
+
+  mInFlight.push_back({mRecording, signalValue, mRingWrite});
+  mRecording = nullptr;
+
+  for (auto& acquire : mRecordingAcquires) {
+    acquire.TimelineValue = signalValue;
+    mSubmittedAcquires.push_back(acquire);
+  }
+  mRecordingAcquires.clear();
+
+  return signalValue;
+}
+
+uint64_t TransferManager::RecordAcquireBarriers(vk::CommandBuffer cmd) {
+  if (!mSubmittedAcquires.empty()) {
+    std::vector<vk::BufferMemoryBarrier> barriers;
+    barriers.reserve(mSubmittedAcquires.size());
+    for (const auto& acquire : mSubmittedAcquires) {
+      barriers.push_back(acquire.Barrier);
+    }
+    cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, ConsumerStages, {}, nullptr,
+                        barriers, nullptr);
+    mSubmittedAcquires.clear();
+  }
+
+  Reclaim();
+
+  return mSubmittedValue;
+}
+
+void TransferManager::WaitIdle() {
+  Flush();
+  if (mSubmittedValue > 0) {
+    const vk::SemaphoreWaitInfo waitInfo({}, *mTimeline, mSubmittedValue);
+    mDevice.waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max());
+  }
+  Reclaim();
+}
+
+bool TransferManager::IsComplete(uint64_t value) const {
+  return mDevice.getSemaphoreCounterValue(*mTimeline) >= value;
+}
+
+vk::DeviceSize TransferManager::ReserveRing(vk::DeviceSize size) {
+  uint64_t start{(mRingWrite + gRingAlignment - 1) & ~(gRingAlignment - 1)};
+  // Allocations never straddle the end of the ring. Skip to the start instead, and let the
+  // skipped tail be reclaimed along with this allocation.
+  if ((start % mRingSize) + size > mRingSize) {
+    start += mRingSize - (start % mRingSize);
+  }
+
+  while (start + size - mRingRead > mRingSize) {
+    Reclaim();
+    if (start + size - mRingRead <= mRingSize) {
+      break;
+    }
+
+    // The ring is full. Make sure our own pending copies are submitted, then wait for the oldest
+    // batch to retire.
+    if (mInFlight.empty()) {
+      Flush();
+    }
+    const vk::SemaphoreWaitInfo waitInfo({}, *mTimeline, mInFlight.front().TimelineValue);
+    mDevice.waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max());
+  }
+
+  mRingWrite = start + size;
+
+  return start % mRingSize;
+}
+
+void TransferManager::Reclaim() {
+  if (mInFlight.empty()) {
+    return;
+  }
+
+  const uint64_t completed{mDevice.getSemaphoreCounterValue(*mTimeline)};
+  while (!mInFlight.empty() && mInFlight.front().TimelineValue <= completed) {
+    mRingRead = mInFlight.front().RingEnd;
+    mFreeCommandBuffers.push_back(mInFlight.front().CommandBuffer);
+    mInFlight.pop_front();
+  }
+}
+
+vk::CommandBuffer TransferManager::GetCommandBuffer() {
+  Reclaim();
+  if (!mFreeCommandBuffers.empty()) {
+    const vk::CommandBuffer cmd{mFreeCommandBuffers.back()};
+    mFreeCommandBuffers.pop_back();
+    cmd.reset();
+
+    return cmd;
+  }
+
+  const vk::CommandBufferAllocateInfo cmdAI(*mCommandPool, vk::CommandBufferLevel::ePrimary, 1);
+
+  return mDevice.allocateCommandBuffers(cmdAI)[0];
+}
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "DeviceAllocator.h"
+#include "VulkanCore.h"
+
+namespace Raven {
+// Streams data into device-local buffers through a persistently mapped staging ring. Copies are
+// recorded on the transfer queue and tracked with a timeline semaphore, so the graphics queue only
+// has to wait on the value returned by Flush() rather than stalling the CPU.
+class TransferManager final {
+ public:
+  TransferManager(vk::Device device, DeviceAllocator& allocator, vk::Queue transferQueue,
+                  uint32_t transferFamily, uint32_t graphicsFamily,
+                  vk::DeviceSize ringSize = 32 * 1024 * 1024);
+  TransferManager(const TransferManager&) = delete;
+  ~TransferManager();
+
+  // Stages the data immediately and records a copy into dst. The copy is submitted on the next
+  // Flush(). dst must not be in use by the graphics queue.
+  void Upload(const Buffer& dst, const void* data, vk::DeviceSize size,
+              vk::DeviceSize dstOffset = 0);
+  // Submits all pending copies, returning the timeline value that will signal their completion.
+  uint64_t Flush();
+  // Records the queue family acquire barriers for any submitted uploads into a graphics command
+  // buffer. Returns the timeline value that command buffer must wait on.
+  uint64_t RecordAcquireBarriers(vk::CommandBuffer cmd);
+  void WaitIdle();
+
+  vk::Semaphore GetTimeline() const noexcept { return *mTimeline; }
+  bool IsComplete(uint64_t value) const;
+
+  // Pipeline stages that may consume uploaded data, used when waiting on the timeline semaphore.
+  static constexpr vk::PipelineStageFlags ConsumerStages{
+      vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eVertexInput |
+      vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eComputeShader};
+
+ private:
+  struct Batch {
+    vk::CommandBuffer CommandBuffer;
+    uint64_t TimelineValue{0};
+    uint64_t RingEnd{0};
+  };
+
+  struct PendingAcquire {
+    vk::BufferMemoryBarrier Barrier;
+    uint64_t TimelineValue{0};
+  };
+
+  vk::DeviceSize ReserveRing(vk::DeviceSize size);
+  void Reclaim();
+  vk::CommandBuffer GetCommandBuffer();
+
+  vk::Device mDevice;
+  vk::Queue mTransferQueue;
+  uint32_t mTransferFamily;
+  uint32_t mGraphicsFamily;
+
+  Buffer mRing;
+  vk::DeviceSize mRingSize;
+  // Positions within the ring are tracked as ever-increasing byte counts, and wrapped with
+  // modulo when addressing the buffer.
+  uint64_t mRingWrite{0};
+  uint64_t mRingRead{0};
+
+  vk::UniqueCommandPool mCommandPool;
+  vk::UniqueSemaphore mTimeline;
+  uint64_t mSubmittedValue{0};
+
+  vk::CommandBuffer mRecording;
+  std::vector<vk::CommandBuffer> mFreeCommandBuffers;
+  std::deque<Batch> mInFlight;
+  std::vector<PendingAcquire> mRecordingAcquires;
+  std::vector<PendingAcquire> mSubmittedAcquires;
+};
+}  // namespace Raven
\ No newline at end of file
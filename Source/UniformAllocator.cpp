@@ -0,0 +1,33 @@
+#include "Core.h"
+
+#include "UniformAllocator.h"
+
+namespace Raven {
+UniformAllocator::UniformAllocator(DeviceAllocator& allocator, vk::DeviceSize size,
+                                   vk::DeviceSize alignment)
+    : mAlignment(alignment) {
+  mBuffer = allocator.CreateBuffer(
+      size, vk::BufferUsageFlagBits::eUniformBuffer,
+      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+}
+
+UniformAllocator::UniformAllocator(UniformAllocator&& o) noexcept { *this = std::move(o); }
+
+UniformAllocator& UniformAllocator::operator=(UniformAllocator&& o) noexcept {
+  mBuffer = std::move(o.mBuffer);
+  mAlignment = o.mAlignment;
+  mUsed = o.mUsed.load();
+
+  return *this;
+}
+
+UniformAllocation UniformAllocator::Allocate(vk::DeviceSize size) {
+  const vk::DeviceSize alignedSize{(size + mAlignment - 1) & ~(mAlignment - 1)};
+  const vk::DeviceSize offset{mUsed.fetch_add(alignedSize)};
+  if (offset + alignedSize > mBuffer.Size) {
+    throw std::runtime_error("Uniform allocator is out of space!");
+  }
+
+  return {static_cast<uint8_t*>(mBuffer.Memory.Mapped) + offset, static_cast<uint32_t>(offset)};
+}
+}  // namespace Raven
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+
+#include "DeviceAllocator.h"
+#include "VulkanCore.h"
+
+namespace Raven {
+struct UniformAllocation {
+  void* Mapped{nullptr};
+  // Passed as the dynamic offset when binding a descriptor set that uses the buffer.
+  uint32_t Offset{0};
+};
+
+// Linear allocator over a persistently mapped, host-coherent uniform buffer. Each frame in flight
+// owns one, and resets it once the GPU is done with that frame, so writing uniform data never
+// needs a map call or a flush. Sub-allocations are bound with dynamic offsets. Allocation is
+// lock-free and may happen from any thread.
+class UniformAllocator final {
+ public:
+  UniformAllocator() = default;
+  UniformAllocator(DeviceAllocator& allocator, vk::DeviceSize size, vk::DeviceSize alignment);
+  UniformAllocator(const UniformAllocator&) = delete;
+  UniformAllocator(UniformAllocator&& o) noexcept;
+  UniformAllocator& operator=(UniformAllocator&& o) noexcept;
+
+  UniformAllocation Allocate(vk::DeviceSize size);
+  template <typename T>
+  uint32_t Push(const T& data) {
+    const UniformAllocation allocation{Allocate(sizeof(T))};
+    memcpy(allocation.Mapped, &data, sizeof(T));
+
+    return allocation.Offset;
+  }
+  void Reset() noexcept { mUsed = 0; }
+
+  const Buffer& GetBuffer() const noexcept { return mBuffer; }
+  vk::DeviceSize Used() const noexcept { return mUsed; }
+
+ private:
+  Buffer mBuffer;
+  vk::DeviceSize mAlignment{1};
+  std::atomic<vk::DeviceSize> mUsed{0};
+};
+}  // namespace Raven
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
 #define VULKAN_HPP_DISPATCH_LOADER_DYNAMIC 1
+#ifdef _WIN32
 #define VK_USE_PLATFORM_WIN32_KHR
+#endif
 
 #include <exception>
 #include <fmt/core.h>
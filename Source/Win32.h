@@ -1,6 +1,8 @@
 #pragma once
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 
-#include <Windows.h>
\ No newline at end of file
+#include <Windows.h>
+#endif
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include "Core.h"
 
-#include "Vulkan/Instance.h"
-#include "Vulkan/Surface.h"
+#include "VulkanCore.h"
 #include "Window.h"
 
 namespace Raven {
+#ifdef _WIN32
 constexpr static const char* gWindowClassName{"Raven"};
 static bool gWindowClassCreated{false};
 
@@ -17,6 +17,23 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     case WM_QUIT:
     case WM_DESTROY:
       return 0;
+
+    case WM_NCCREATE: {
+      const CREATESTRUCTA* create{reinterpret_cast<const CREATESTRUCTA*>(lParam)};
+      ::SetWindowLongPtrA(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(create->lpCreateParams));
+      break;
+    }
+
+    // The new size is picked up by the renderer, which rebuilds its swapchain to match. Minimizing
+    // reports a size of zero.
+    case WM_SIZE: {
+      Window* window{reinterpret_cast<Window*>(::GetWindowLongPtrA(hwnd, GWLP_USERDATA))};
+      if (window) {
+        window->mWidth = LOWORD(lParam);
+        window->mHeight = HIWORD(lParam);
+      }
+      break;
+    }
   }
 
   return DefWindowProcA(hwnd, msg, wParam, lParam);
@@ -47,7 +64,7 @@ Window::Window() {
     gWindowClassCreated = true;
   }
 
-  const DWORD style{WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU | WS_VISIBLE};
+  const DWORD style{WS_OVERLAPPEDWINDOW | WS_VISIBLE};
   const DWORD exStyle{WS_EX_OVERLAPPEDWINDOW};
 
   RECT windowRect{};
@@ -71,7 +88,7 @@ Window::Window() {
                               nullptr,           // hWndParent
                               nullptr,           // hMenu
                               inst,              // hInstance
-                              nullptr            // lpParam
+                              this               // lpParam
   );
   ::ShowWindow(mHandle, SW_SHOW);
 }
@@ -79,6 +96,12 @@ Window::Window() {
 Window::~Window() { ::DestroyWindow(mHandle); }
 
 bool Window::Update() noexcept {
+  // A minimized window renders nothing, so block until a message arrives, such as the WM_SIZE of
+  // being restored, instead of spinning through empty frames.
+  if (mWidth == 0 || mHeight == 0) {
+    ::WaitMessage();
+  }
+
   MSG msg;
   while (::PeekMessageA(&msg, nullptr, 0, 0, PM_REMOVE)) {
     if (msg.message == WM_QUIT) {
@@ -102,4 +125,24 @@ void Window::SetTitle(const std::string& title) noexcept {
 vk::UniqueSurfaceKHR Window::CreateSurface(const vk::Instance& instance) const {
   return instance.createWin32SurfaceKHRUnique({{}, ::GetModuleHandleA(nullptr), mHandle});
 }
+#else
+// Windowed output is only implemented for Win32. Other platforms run Raven in headless mode.
+Window::Window() : mWidth(0), mHeight(0) {
+  throw std::runtime_error("Windowed mode is not supported on this platform!");
+}
+
+Window::~Window() {}
+
+bool Window::Update() noexcept { return false; }
+
+uint32_t Window::Width() const noexcept { return mWidth; }
+
+uint32_t Window::Height() const noexcept { return mHeight; }
+
+void Window::SetTitle(const std::string& title) noexcept {}
+
+vk::UniqueSurfaceKHR Window::CreateSurface(const vk::Instance& instance) const {
+  throw std::runtime_error("Windowed mode is not supported on this platform!");
+}
+#endif
 }  // namespace Raven
\ No newline at end of file
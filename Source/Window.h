@@ -22,7 +22,11 @@ class Window final {
   vk::UniqueSurfaceKHR CreateSurface(const vk::Instance& instance) const;
 
  private:
+#ifdef _WIN32
+  friend LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+
   HWND mHandle;
+#endif
   uint32_t mWidth;
   uint32_t mHeight;
 };